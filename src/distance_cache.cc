@@ -0,0 +1,205 @@
+#include "distance_cache.hh"
+
+#include <fmt/core.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "src/path_finder.hh"
+#include "src/tilemap.hh"
+#include "src/tilemap_woodland.hh"
+#include "utils/bit_bfs.hh"
+#include "utils/bit_grid.hh"
+#include "utils/coordinate.hh"
+#include "utils/distance_field.hh"
+#include "utils/mapped_file.hh"
+
+namespace {
+
+constexpr auto MAGIC   = std::array{'P', 'F', 'D', 'F'};
+constexpr auto VERSION = uint32_t{1};
+
+//
+// Header preceding the distance values in a cache file. The distance values
+// follow directly, as (width * height) native endian 32-bit values.
+//
+struct Header {
+  std::array<char, 4> magic;
+  uint32_t version;
+  uint64_t passability;
+  uint32_t width;
+  uint32_t height;
+  int32_t target_x;
+  int32_t target_y;
+};
+
+static_assert(sizeof(Header) % alignof(uint32_t) == 0);
+
+[[nodiscard]] auto headerFor(const Utils::BitGrid& passable,
+                             Utils::Coordinate target) -> Header {
+  return {.magic       = MAGIC,
+          .version     = VERSION,
+          .passability = passable.hash(),
+          .width       = static_cast<uint32_t>(passable.width()),
+          .height      = static_cast<uint32_t>(passable.height()),
+          .target_x    = target.x,
+          .target_y    = target.y};
+}
+
+//
+// distancesIn() returns the distance values of a mapped cache file, or
+// std::nullopt if the file does not match the |expected| header.
+//
+[[nodiscard]] auto distancesIn(const Utils::MappedFile& file,
+                               const Header& expected)
+    -> std::optional<std::span<const uint32_t>> {
+  const auto bytes = file.bytes();
+  const auto count = size_t{expected.width} * expected.height;
+  if (bytes.size() != sizeof(Header) + (count * sizeof(uint32_t)))
+    return std::nullopt;
+
+  auto header = Header{};
+  std::memcpy(&header, bytes.data(), sizeof(Header));
+  if (header.magic != expected.magic or header.version != expected.version or
+      header.passability != expected.passability or
+      header.width != expected.width or header.height != expected.height or
+      header.target_x != expected.target_x or
+      header.target_y != expected.target_y)
+    return std::nullopt;
+
+  // Mappings are page aligned, and the header size is a multiple of the value
+  // alignment, so the values can be accessed in place.
+  return std::span{
+      reinterpret_cast<const uint32_t*>(bytes.subspan(sizeof(Header)).data()),
+      count};
+}
+
+//
+// write() stores a distance field in a cache file. The file is written under
+// a temporary name first, so readers never observe a partial file.
+//
+[[nodiscard]] auto write(const std::filesystem::path& path,
+                         const Header& header,
+                         const Utils::DistanceField& field) -> bool {
+  auto temporary = path;
+  temporary += ".tmp";
+  {
+    auto file = std::ofstream(temporary, std::ios::binary | std::ios::trunc);
+    const auto values = field.data();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    file.write(reinterpret_cast<const char*>(values.data()),
+               static_cast<std::streamsize>(values.size_bytes()));
+    if (!file) return false;
+  }
+
+  auto error = std::error_code{};
+  std::filesystem::rename(temporary, path, error);
+  return !error;
+}
+
+}  // namespace
+
+namespace path_finder {
+
+DistanceCache::DistanceCache(std::filesystem::path directory)
+    : directory_{std::move(directory)} {
+  auto error = std::error_code{};
+  std::filesystem::create_directories(directory_, error);
+}
+
+auto DistanceCache::field(const Utils::BitGrid& passable,
+                          Utils::Coordinate target)
+    -> Utils::DistanceFieldView {
+  const auto header = headerFor(passable, target);
+  const auto path   = directory_ / fmt::format("{:016x}_{}_{}.field",
+                                               header.passability, target.x,
+                                               target.y);
+
+  if (auto file = Utils::MappedFile::open(path)) {
+    if (const auto distances = distancesIn(*file, header)) {
+      ++stats_.hits;
+      mapped_.push_back(std::move(*file));
+      return {passable.width(), passable.height(), *distances};
+    }
+    ++stats_.invalidations;
+  } else if (auto error = std::error_code{};
+             std::filesystem::exists(path, error)) {
+    // Empty cache files (ex. an interrupted write) cannot be mapped
+    ++stats_.invalidations;
+  } else {
+    ++stats_.misses;
+  }
+
+  auto field = Utils::BitBfs::find(passable, target);
+  if (write(path, header, field)) {
+    if (auto file = Utils::MappedFile::open(path)) {
+      if (const auto distances = distancesIn(*file, header)) {
+        mapped_.push_back(std::move(*file));
+        return {passable.width(), passable.height(), *distances};
+      }
+    }
+  }
+
+  // Moving a DistanceField (ex. when |computed_| grows) keeps its distance
+  // values in place, so previously returned views remain valid.
+  computed_.push_back(std::move(field));
+  return {passable.width(), passable.height(), computed_.back().data()};
+}
+
+//
+// unitPaths() variant that resolves every target through the distance field
+// |cache|.
+//
+[[nodiscard]] auto unitPaths(const tilemap::Grid& grid, DistanceCache& cache)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>> {
+  return unitPaths(grid, tilemap::TileIndex{grid}, cache);
+}
+
+//
+// unitPaths() variant that resolves every target through the distance field
+// |cache|, locating units and targets through the tile |index|.
+//
+[[nodiscard]] auto unitPaths(const tilemap::Grid& grid,
+                             const tilemap::TileIndex& index,
+                             DistanceCache& cache)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>> {
+  return unitPaths(passabilityOf(grid), index, cache);
+}
+
+//
+// unitPaths() variant for maps given by their |passable| layer and tile
+// |index| alone.
+//
+[[nodiscard]] auto unitPaths(const Utils::BitGrid& passable,
+                             const tilemap::TileIndex& index,
+                             DistanceCache& cache)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>> {
+  auto routes =
+      std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>{};
+
+  for (const auto& route : tilemap::woodland::UNIT_TARGETS) {
+    const auto maybe_target = index.find(route.target_tile);
+    if (!maybe_target) continue;
+
+    const auto units = index.findAll(route.unit_tile);
+    if (units.empty()) continue;
+
+    const auto field = cache.field(passable, *maybe_target);
+    for (const auto& unit_start : units) {
+      if (!field.contains(unit_start)) continue;
+      routes[unit_start] = tracePath(field, unit_start, *maybe_target);
+    }
+  }
+  return routes;
+}
+
+}  // namespace path_finder
@@ -0,0 +1,84 @@
+#ifndef DISTANCE_CACHE_HH
+#define DISTANCE_CACHE_HH
+
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+#include "src/tilemap.hh"
+#include "utils/bit_grid.hh"
+#include "utils/coordinate.hh"
+#include "utils/distance_field.hh"
+#include "utils/mapped_file.hh"
+
+namespace path_finder {
+
+//
+// DistanceCache keeps per-target distance fields (see findDistanceField()) in
+// files on disk, so repeated runs over the same map skip the search entirely.
+//
+// Cache files are keyed by a hash of the passability layer of the map and the
+// target coordinate. The file holds a small header followed by the raw
+// distance values, which are memory mapped and traced in place on a cache hit.
+//
+// A cache file that does not match the map it was requested for (ex. from an
+// older version, or a truncated write) is counted as an invalidation and is
+// replaced by a freshly computed distance field.
+//
+class DistanceCache {
+ public:
+  struct Stats {
+    size_t hits{};
+    size_t misses{};
+    size_t invalidations{};
+  };
+
+  [[nodiscard]] explicit DistanceCache(std::filesystem::path directory);
+
+  //
+  // field() returns the distance field towards |target| on the map with the
+  // given |passable| layer (see passabilityOf()).
+  //
+  // The returned view remains valid for the lifetime of the cache.
+  //
+  [[nodiscard]] auto field(const Utils::BitGrid& passable,
+                           Utils::Coordinate target)
+      -> Utils::DistanceFieldView;
+
+  [[nodiscard]] auto stats() const -> const Stats& { return stats_; }
+
+ private:
+  std::filesystem::path directory_;
+  Stats stats_{};
+
+  // Storage backing the returned views; fields that could not be written to
+  // disk are kept in memory instead.
+  std::vector<Utils::MappedFile> mapped_{};
+  std::vector<Utils::DistanceField> computed_{};
+};
+
+//
+// unitPaths() variant that resolves every target through the distance field
+// |cache|. Units and targets are located through a tile index of the |grid|
+// (see tilemap::TileIndex), which may be given if already available.
+//
+[[nodiscard]] auto unitPaths(const tilemap::Grid& grid, DistanceCache& cache)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>;
+
+[[nodiscard]] auto unitPaths(const tilemap::Grid& grid,
+                             const tilemap::TileIndex& index,
+                             DistanceCache& cache)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>;
+
+//
+// unitPaths() variant for maps given by their |passable| layer (see
+// passabilityOf()) and tile |index| alone, ex. a tilemap::CompiledMap.
+//
+[[nodiscard]] auto unitPaths(const Utils::BitGrid& passable,
+                             const tilemap::TileIndex& index,
+                             DistanceCache& cache)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>;
+
+}  // namespace path_finder
+
+#endif  // DISTANCE_CACHE_HH
@@ -0,0 +1,90 @@
+#include <filesystem>
+#include <fstream>
+
+#include "src/distance_cache.hh"
+#include "src/path_finder.hh"
+#include "src/tilemap.hh"
+#include "testrunner/testrunner.h"
+#include "utils/coordinate.hh"
+
+namespace {
+
+constexpr auto FIVE_BY_FIVE_TEST_MAP =
+    R"({"layers":[{"tileset":"MapEditor Tileset_woodland.png",
+"data":[8.4,3,-1,-1,-1,-1,3,-1,-1,-1,-1,3,-1,3,-1,-1,-1,
+-1,3,-1,-1,-1,-1,3,0.6]}],"tilesets":[{"tilewidth":32,"tileheight":32}],
+"canvas":{"width":160,"height":160}})";
+
+//
+// Creates an empty cache directory, removing any left-overs of previous runs
+//
+[[nodiscard]] auto emptyCacheDirectory() -> std::filesystem::path {
+  const auto directory =
+      std::filesystem::temp_directory_path() / "pathfinder_cache_tests";
+  std::filesystem::remove_all(directory);
+  return directory;
+}
+
+}  // namespace
+
+TEST(DistanceCache_Reports_miss_then_hit) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto directory     = emptyCacheDirectory();
+  const auto expected      = path_finder::unitPaths(grid);
+  ASSERT_TRUE(expected.contains({}));
+
+  {
+    auto cache            = path_finder::DistanceCache{directory};
+    const auto unit_paths = path_finder::unitPaths(grid, cache);
+    EXPECT_EQ(unit_paths.size(), 1);
+    EXPECT_EQ(unit_paths.at({}).size(), expected.at({}).size());
+    EXPECT_EQ(cache.stats().misses, 1);
+    EXPECT_EQ(cache.stats().hits, 0);
+  }
+
+  auto cache            = path_finder::DistanceCache{directory};
+  const auto unit_paths = path_finder::unitPaths(grid, cache);
+  EXPECT_EQ(unit_paths.size(), 1);
+  EXPECT_EQ(unit_paths.at({}).size(), expected.at({}).size());
+  EXPECT_EQ(cache.stats().misses, 0);
+  EXPECT_EQ(cache.stats().hits, 1);
+  std::filesystem::remove_all(directory);
+}
+
+TEST(DistanceCache_Replaces_invalid_cache_files) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto directory     = emptyCacheDirectory();
+  const auto passable      = path_finder::passabilityOf(grid);
+  const auto target        = Utils::Coordinate{.x = 4, .y = 4};
+
+  {
+    auto cache = path_finder::DistanceCache{directory};
+    ASSERT_TRUE(cache.field(passable, target).contains({}));
+  }
+
+  // Overwrite all cache files
+  for (const auto& entry : std::filesystem::directory_iterator(directory))
+    std::ofstream(entry.path(), std::ios::trunc) << "garbage";
+
+  auto cache       = path_finder::DistanceCache{directory};
+  const auto field = cache.field(passable, target);
+  EXPECT_EQ(cache.stats().invalidations, 1);
+  EXPECT_EQ(field.distance({}),
+            path_finder::findDistanceField(grid, target).distance({}));
+
+  // Truncate all cache files to zero length
+  for (const auto& entry : std::filesystem::directory_iterator(directory))
+    std::ofstream(entry.path(), std::ios::trunc);
+
+  auto truncated = path_finder::DistanceCache{directory};
+  ASSERT_TRUE(truncated.field(passable, target).contains({}));
+  EXPECT_EQ(truncated.stats().invalidations, 1);
+  EXPECT_EQ(truncated.stats().misses, 0);
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,97 @@
+#include <fmt/core.h>
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "utils/coordinate.hh"
+#include "utils/grid.hh"
+
+namespace {
+
+// Share of impassable tiles on the benchmark map, in percent
+constexpr auto OBSTACLES = 30U;
+
+//
+// flood() runs a breadth-first search from the center of a |size| x |size|
+// map with randomly placed obstacles, storing both the map and the distances
+// in the given LAYOUT. Returns the number of tiles reached.
+//
+template <typename LAYOUT>
+[[nodiscard]] auto flood(size_t size) -> size_t {
+  using Undefined = Utils::OutOfBoundsPolicy::Undefined;
+
+  auto passable = Utils::Grid<uint8_t, Undefined, LAYOUT>{size, size};
+  auto random   = std::minstd_rand{};
+  for (const auto pos : passable.coordinates())
+    passable[pos] = random() % 100 >= OBSTACLES ? 1 : 0;
+
+  const auto start = Utils::Coordinate{.x = static_cast<int>(size / 2),
+                                       .y = static_cast<int>(size / 2)};
+  passable[start]  = 1;
+
+  auto distances = Utils::Grid<int, Undefined, LAYOUT>{size, size};
+  auto frontier  = std::vector{start};
+  auto next      = std::vector<Utils::Coordinate>{};
+  auto reached   = size_t{1};
+
+  distances[start] = 1;
+
+  while (!frontier.empty()) {
+    for (const auto from : frontier) {
+      for (const auto to : from.neighborsUpDownLeftRight()) {
+        if (!passable.inBounds(to) or passable[to] == 0 or distances[to] != 0)
+          continue;
+        distances[to] = distances[from] + 1;
+        next.push_back(to);
+        ++reached;
+      }
+    }
+    std::swap(frontier, next);
+    next.clear();
+  }
+  return reached;
+}
+
+//
+// measure() prints the time taken by flood() for the given LAYOUT.
+//
+template <typename LAYOUT>
+void measure(std::string_view name, size_t size) {
+  const auto start   = std::chrono::steady_clock::now();
+  const auto reached = flood<LAYOUT>(size);
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  fmt::print("{:<10} {:>6} ms  ({} tiles reached)\n", name, elapsed.count(),
+             reached);
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  const auto args = std::span{argv, static_cast<size_t>(argc)};
+  auto size       = size_t{2048};
+  auto valid      = args.size() <= 2;
+  if (args.size() == 2) {
+    const auto arg = std::string_view{args[1]};
+    const auto [end, error] =
+        std::from_chars(arg.data(), arg.data() + arg.size(), size);
+    valid = error == std::errc{} and end == arg.data() + arg.size() and
+            size > 0;
+  }
+  if (!valid) {
+    fmt::print(stderr, "Usage: {} [map size]\n", args.front());
+    return 1;
+  }
+
+  measure<Utils::LayoutPolicy::RowMajor>("RowMajor", size);
+  measure<Utils::LayoutPolicy::Tiled<>>("Tiled", size);
+  measure<Utils::LayoutPolicy::ZOrder>("ZOrder", size);
+  return 0;
+}
@@ -0,0 +1,80 @@
+#include <fmt/core.h>
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#include "src/tilemap.hh"
+#include "src/tilemap_compiled.hh"
+#include "src/tilemap_palette.hh"
+#include "utils/file_content.hh"
+
+namespace {
+
+//
+// write() stores the compiled map |bytes| in a file. The file is written under
+// a temporary name first, so readers never observe a partial file.
+//
+[[nodiscard]] auto write(const std::filesystem::path& path,
+                         std::string_view bytes) -> bool {
+  auto temporary = path;
+  temporary += ".tmp";
+  {
+    auto file = std::ofstream(temporary, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    if (!file) return false;
+  }
+
+  auto error = std::error_code{};
+  std::filesystem::rename(temporary, path, error);
+  return !error;
+}
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  const auto args = std::span{argv, static_cast<size_t>(argc)};
+  auto selected   = std::optional<tilemap::LayerSelection>{};
+  if (args.size() == 3) {
+    selected.emplace();
+  } else if (args.size() == 5 and std::string_view{args[1]} == "--layers") {
+    selected = tilemap::LayerSelection::parse(args[2]);
+  }
+  if (!selected) {
+    fmt::print(stderr,
+               "Usage: {} [--layers LAYERS] <map_file.json | -> "
+               "<map_file.pfmap>\n",
+               args.front());
+    return 1;
+  }
+
+  const auto map_file = Utils::FileContent::open(args[args.size() - 2]);
+  if (!map_file or map_file->text().empty()) {
+    fmt::print(stderr, "Error: Unable to read map from file\n");
+    return 2;
+  }
+
+  auto index               = tilemap::TileIndex{};
+  const auto maybe_tilemap =
+      tilemap::compactFromJson(map_file->text(), index, *selected);
+  if (!maybe_tilemap) {
+    // Compiled maps hold the compact grid, which has room for a limited
+    // number of distinct tiles only
+    if (tilemap::fromJson(map_file->text(), *selected)) {
+      fmt::print(stderr, "Error: Too many distinct tiles to compile map\n");
+    } else {
+      fmt::print(stderr, "Error: Unable to parse JSON tilemap\n");
+    }
+    return 3;
+  }
+
+  const auto& [info, grid] = *maybe_tilemap;
+  if (!write(args.back(), tilemap::toCompiledMap(info, grid, index))) {
+    fmt::print(stderr, "Error: Unable to write compiled map\n");
+    return 4;
+  }
+  return 0;
+}
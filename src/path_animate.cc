@@ -1,16 +1,23 @@
 #include <fmt/core.h>
 
 #include <filesystem>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "path_finder.hh"
 #include "src/tilemap.hh"
+#include "src/tilemap_compiled.hh"
 #include "src/tilemap_woodland.hh"
 #include "src/window.hh"
 #include "utils/coordinate.hh"
 #include "utils/coordinate_formatter.hh"  // IWYU pragma: keep
+#include "utils/file_content.hh"
 #include "utils/one_of.hh"
-#include "utils/read_file.hh"
 
 namespace {
 
@@ -26,69 +33,134 @@ namespace {
 }
 
 //
-// animate() shows the units travelling to their respective targets.
+// animate() shows the units travelling to their respective targets, on top of
+// the |background| layers.
 //
-void animate(const tilemap::Info& map_info, const tilemap::Grid& map) {
-  auto unit_paths = path_finder::unitPaths(map);
-  auto grid       = map;
-
+void animate(const tilemap::Info& map_info, const tilemap::Layers& background,
+             const tilemap::Grid& map) {
+  using Cursor = path_finder::PathCursor<path_finder::CompactPath>;
+
+  auto unit_paths =
+      std::unordered_map<Utils::Coordinate, path_finder::CompactPath>{};
+  auto cursors = std::vector<Cursor>{};
+
+  // (Re)starts all units at the beginning of their paths
+  const auto reset = [&] {
+    unit_paths = path_finder::compactUnitPaths(map);
+    cursors.clear();
+    for (const auto& [unit, path] : unit_paths) cursors.emplace_back(path);
+  };
+  reset();
+
+  auto grid   = map;
   auto paused = false;
   auto window = path_finder::Window(map_info);
 
   while (window.isOpen()) {
     if (auto event = window.handleEvents()) {
       if (event == path_finder::Event::Reset) {
-        grid       = map;
-        unit_paths = path_finder::unitPaths(map);
+        grid = map;
+        reset();
 
       } else if (event == path_finder::Event::PauseResume) {
         paused = !paused;
       }
     }
-    window.draw(grid);
+    window.draw(background, grid);
 
     if (paused) continue;
 
-    for (auto& [unit, path] : unit_paths) {
-      if (path.empty()) continue;
+    // Every unit advances along its path by a cursor, so each frame takes
+    // O(units) time regardless of the path lengths.
+    for (auto& cursor : cursors) {
+      if (cursor.done()) continue;
 
-      const auto from = path.front();
-      if (path.size() == 1) {
+      const auto from = cursor.position();
+      const auto to   = cursor.next();
+      if (!to) {
         grid[from] = map[from];  // Restore target tile
-        path.clear();
+        cursor.advance();
         continue;
       }
 
-      const auto to = *std::next(path.begin());
-      if (canMoveTo(grid, to)) {
-        grid[to] = std::exchange(grid[from], {});
-        path.erase(path.begin());  // Pop front (inefficient)
+      if (canMoveTo(grid, *to)) {
+        grid[*to] = std::exchange(grid[from], {});
+        cursor.advance();
       }
     }
   }
 }
 
+//
+// animateJsonMap() animates the |selected| layers of a RiskyLab JSON map, and
+// returns the exit code. All other layers are drawn as the background.
+//
+[[nodiscard]] auto animateJsonMap(std::string_view json_text,
+                                  const tilemap::LayerSelection& selected)
+    -> int {
+  auto maybe_layers =
+      tilemap::layersFromJson(json_text, tilemap::LayerSelection::all());
+  if (!maybe_layers) {
+    fmt::print(stderr, "Error: Unable to parse JSON tilemap\n");
+    return 3;
+  }
+
+  auto& [info, layers] = *maybe_layers;
+  auto background      = tilemap::Layers{};
+  auto units           = tilemap::Layers{};
+  for (auto& layer : layers) {
+    auto& into =
+        selected.includes(layer.position, layer.name) ? units : background;
+    into.push_back(std::move(layer));
+  }
+  if (units.empty()) {
+    fmt::print(stderr, "Error: No map layer selected\n");
+    return 3;
+  }
+
+  animate(info, background, tilemap::flatten(units));
+  return 0;
+}
+
 }  // namespace
 
 auto main(int argc, char* argv[]) -> int {
   const auto args = std::span{argv, static_cast<size_t>(argc)};
-  if (args.size() != 2) {
-    fmt::print(stderr, "Usage: {} <map_file.json>\n", args.front());
+  auto selected   = std::optional<tilemap::LayerSelection>{};
+  if (args.size() == 2) {
+    selected.emplace();
+  } else if (args.size() == 4 and std::string_view{args[1]} == "--layers") {
+    selected = tilemap::LayerSelection::parse(args[2]);
+  }
+  if (!selected) {
+    fmt::print(stderr, "Usage: {} [--layers LAYERS] <map_file | ->\n",
+               args.front());
     return 1;
   }
 
-  const auto json_text = Utils::readFile(args[1]);
-  if (json_text.empty()) {
+  const auto map_file = Utils::FileContent::open(args.back());
+  if (!map_file or map_file->text().empty()) {
     fmt::print(stderr, "Error: Unable to read map from file\n");
     return 2;
   }
 
-  const auto maybe_tilemap = tilemap::fromJson(json_text);
-  if (!maybe_tilemap) {
-    fmt::print(stderr, "Error: Unable to parse JSON tilemap\n");
-    return 3;
+  // Compiled maps (see compile_map) are expanded into a full grid, which the
+  // animation updates as units travel.
+  if (tilemap::isCompiledMap(map_file->text())) {
+    if (args.size() != 2) {
+      fmt::print(stderr,
+                 "Error: --layers cannot be used with compiled maps\n");
+      return 1;
+    }
+
+    const auto maybe_map = tilemap::fromCompiledMap(map_file->text());
+    if (!maybe_map) {
+      fmt::print(stderr, "Error: Unable to load compiled tilemap\n");
+      return 3;
+    }
+    animate(maybe_map->info, {}, maybe_map->grid.expand());
+    return 0;
   }
 
-  const auto& [info, grid] = *maybe_tilemap;
-  animate(info, grid);
+  return animateJsonMap(map_file->text(), *selected);
 }
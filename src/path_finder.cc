@@ -1,14 +1,302 @@
 #include "path_finder.hh"
 
-#include <ranges>
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "src/tilemap.hh"
+#include "src/tilemap_palette.hh"
 #include "src/tilemap_woodland.hh"
+#include "utils/astar.hh"
+#include "utils/bidirectional.hh"
+#include "utils/bit_bfs.hh"
+#include "utils/bit_grid.hh"
+#include "utils/compact_path.hh"
 #include "utils/coordinate.hh"
+#include "utils/cost_grid.hh"
+#include "utils/d_star_lite.hh"
 #include "utils/dijkstras.hh"
+#include "utils/distance_field.hh"
+#include "utils/grid_dijkstra.hh"
+#include "utils/hierarchical_astar.hh"
+#include "utils/jump_point_search.hh"
+#include "utils/label_flood.hh"
+#include "utils/neighborhood.hh"
+#include "utils/parallel_for.hh"
+#include "utils/search_context.hh"
+
+namespace {
+
+//
+// isPassable() returns true if a unit can travel across the given |grid|
+// position, i.e. if its tile is not IMPASSABLE (see woodland::TERRAIN_COSTS).
+//
+// This resolves the terrain of the tile on every call. Searches across the
+// whole map read the materialized cost grid instead (see passableOn()).
+//
+[[nodiscard]] auto isPassable(const tilemap::Grid& grid, Utils::Coordinate pos)
+    -> bool {
+  return grid.inBounds(pos) and tilemap::woodland::terrainCost(grid[pos]) !=
+                                    Utils::CostGrid::IMPASSABLE;
+}
+
+//
+// passableOn() returns a predicate that returns true if a unit can travel
+// across a given position of the terrain |costs|, with a single load.
+//
+[[nodiscard]] auto passableOn(const Utils::CostGrid& costs) {
+  return [&costs](Utils::Coordinate pos) { return costs.passable(pos); };
+}
+
+//
+// adjacentTo() returns a callable that returns all neighbors of a given
+// coordinate position (as defined by the NEIGHBORHOOD policy) for which the
+// |passable| predicate returns true.
+//
+// The neighbors are collected into a fixed size array (see
+// Utils::NeighborhoodPolicy), so expanding a node does not allocate.
+//
+template <typename EDGE,
+          typename NEIGHBORHOOD = path_finder::Neighborhood::FourConnected>
+[[nodiscard]] auto adjacentTo(auto passable) {
+  return [passable](const Utils::Coordinate& from) {
+    return NEIGHBORHOOD::template adjacent<EDGE>(from, passable);
+  };
+}
+
+//
+// adjacentTo() variant that returns all non-elevated neighbors of a given
+// coordinate position on the |grid|.
+//
+template <typename EDGE,
+          typename NEIGHBORHOOD = path_finder::Neighborhood::FourConnected>
+[[nodiscard]] auto adjacentTo(const tilemap::Grid& grid) {
+  return adjacentTo<EDGE, NEIGHBORHOOD>(
+      [&grid](auto pos) { return isPassable(grid, pos); });
+}
+
+//
+// adjacentTo() variant that returns all enterable neighbors of a given
+// coordinate position on weighted terrain, with the distance to each neighbor
+// weighed by its |costs|.
+//
+template <typename EDGE,
+          typename NEIGHBORHOOD = path_finder::Neighborhood::FourConnected>
+[[nodiscard]] auto adjacentTo(const Utils::CostGrid& costs) {
+  return [&costs](const Utils::Coordinate& from) {
+    return NEIGHBORHOOD::template adjacent<EDGE>(from, costs);
+  };
+}
+
+//
+// unitPath() returns the path for a single unit to its target using the A*
+// algorithm, or an empty vector if the unit cannot reach the target.
+//
+// The search runs from the target towards the unit, so the resulting previous
+// map can be traced by tracePath() just like the findPath() results.
+//
+[[nodiscard]] auto unitPath(Utils::Coordinate unit, Utils::Coordinate target,
+                            auto&& passable) -> std::vector<Utils::Coordinate> {
+  using path_finder::AStar;
+  const auto heuristic = [&](const auto& from) {
+    return from.manhattanDistanceFrom(unit);
+  };
+  const auto [_, previous] = AStar::find(
+      {0, target}, unit, adjacentTo<AStar::Edge>(passable), heuristic);
+  if (!previous.contains(unit)) return {};
+  return path_finder::tracePath(previous, unit, target);
+}
+
+constexpr auto COLORS = tilemap::woodland::UNIT_TARGETS.size();
+
+using Targets = std::array<std::optional<Utils::Coordinate>, COLORS>;
+using Units   = std::array<std::vector<Utils::Coordinate>, COLORS>;
+
+//
+// routeUnits() returns a path for each unit that can reach the target of its
+// color on a |width| x |height| map.
+//
+// Colors with only a single unit are resolved using the A* algorithm. All
+// other targets are flooded at once, in a single pass over the map.
+//
+// The PATH parameter selects the path representation; either a
+// std::vector<Utils::Coordinate> or a path_finder::CompactPath.
+//
+template <typename PATH>
+[[nodiscard]] auto routeUnits(size_t width, size_t height, Targets targets,
+                              const Units& units, auto&& passable)
+    -> std::unordered_map<Utils::Coordinate, PATH> {
+  auto routes = std::unordered_map<Utils::Coordinate, PATH>{};
+
+  for (auto color = size_t{}; color < COLORS; ++color) {
+    if (!targets[color] or units[color].empty()) {
+      targets[color] = std::nullopt;
+      continue;
+    }
+
+    // A single unit does not warrant flooding the entire map
+    if (units[color].size() == 1) {
+      const auto unit = units[color].front();
+      auto path       = unitPath(unit, *targets[color], passable);
+      if (!path.empty()) {
+        if constexpr (std::is_same_v<PATH, path_finder::CompactPath>) {
+          routes[unit] = PATH::from(path);
+        } else {
+          routes[unit] = std::move(path);
+        }
+      }
+      targets[color] = std::nullopt;
+    }
+  }
+
+  if (std::ranges::none_of(targets, [](auto target) { return !!target; }))
+    return routes;
+
+  const auto flood =
+      path_finder::LabelFlood::find(width, height, targets, passable);
+
+  for (auto color = size_t{}; color < COLORS; ++color) {
+    if (!targets[color]) continue;
+
+    const auto previous = flood.pathMap(color);
+    for (const auto& unit_start : units[color]) {
+      if (!previous.contains(unit_start)) continue;
+      if constexpr (std::is_same_v<PATH, path_finder::CompactPath>) {
+        routes[unit_start] = path_finder::traceCompactPath(
+            previous, unit_start, *targets[color]);
+      } else {
+        routes[unit_start] =
+            path_finder::tracePath(previous, unit_start, *targets[color]);
+      }
+    }
+  }
+  return routes;
+}
+
+//
+// routeUnits() variant operating on the compact grid representation.
+//
+template <typename PATH>
+[[nodiscard]] auto routeUnits(const tilemap::CompactGrid& grid)
+    -> std::unordered_map<Utils::Coordinate, PATH> {
+  // Locate all units and targets in a single pass, using the property table
+  auto targets = Targets{};
+  auto units   = Units{};
+  for (const auto pos : grid.ids().coordinates()) {
+    const auto& properties = grid.properties(pos);
+    if (properties.unit_color) units[*properties.unit_color].push_back(pos);
+    if (properties.target_color and !targets[*properties.target_color])
+      targets[*properties.target_color] = pos;
+  }
+  return routeUnits<PATH>(grid.width(), grid.height(), targets, units,
+                          [&](auto pos) { return grid.passable(pos); });
+}
+
+//
+// routeUnits() variant that locates all units and targets through the tile
+// |index| of a |width| x |height| map.
+//
+template <typename PATH>
+[[nodiscard]] auto routeUnits(size_t width, size_t height,
+                              const tilemap::TileIndex& index, auto&& passable)
+    -> std::unordered_map<Utils::Coordinate, PATH> {
+  auto targets = Targets{};
+  auto units   = Units{};
+  for (auto color = size_t{}; color < COLORS; ++color) {
+    const auto& route = tilemap::woodland::UNIT_TARGETS[color];
+    targets[color]    = index.find(route.target_tile);
+    units[color]      = index.findAll(route.unit_tile);
+  }
+  return routeUnits<PATH>(width, height, targets, units, passable);
+}
+
+template <typename PATH>
+[[nodiscard]] auto routeUnits(const tilemap::Grid& grid,
+                              const tilemap::TileIndex& index)
+    -> std::unordered_map<Utils::Coordinate, PATH> {
+  const auto costs = path_finder::terrainCostsOf(grid);
+  return routeUnits<PATH>(grid.width(), grid.height(), index,
+                          passableOn(costs));
+}
+
+template <typename PATH>
+[[nodiscard]] auto routeUnits(const tilemap::CompactGrid& grid,
+                              const tilemap::TileIndex& index)
+    -> std::unordered_map<Utils::Coordinate, PATH> {
+  return routeUnits<PATH>(grid.width(), grid.height(), index,
+                          [&](auto pos) { return grid.passable(pos); });
+}
+
+//
+// routeUnitsInParallel() returns a path for each unit that can reach the
+// target of its color on a |width| x |height| map, spreading the work across
+// up to |threads| worker threads. Units and targets are located through the
+// tile |index|.
+//
+[[nodiscard]] auto routeUnitsInParallel(size_t width, size_t height,
+                                        const tilemap::TileIndex& index,
+                                        size_t threads, auto&& passable)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>> {
+  struct Route {
+    Utils::Coordinate target;
+    std::vector<Utils::Coordinate> units;
+  };
+
+  auto routes = std::vector<Route>{};
+  for (const auto& route : tilemap::woodland::UNIT_TARGETS) {
+    const auto maybe_target = index.find(route.target_tile);
+    if (!maybe_target) continue;
+
+    auto units = index.findAll(route.unit_tile);
+    if (units.empty()) continue;
+    routes.push_back({.target = *maybe_target, .units = std::move(units)});
+  }
+
+  // Each target is flooded on its own, which yields the same paths as the
+  // combined LabelFlood used by the sequential unitPaths().
+  using Flood = Utils::LabelFlood<1>;
+  auto floods = std::vector<std::optional<Flood>>(routes.size());
+  Utils::parallelFor(routes.size(), threads, [&](size_t route) {
+    // A single unit does not warrant flooding the entire map
+    if (routes[route].units.size() == 1) return;
+    floods[route] =
+        Flood::find(width, height, {routes[route].target}, passable);
+  });
+
+  // Every unit is traced into its own result slot, so workers never contend
+  auto units = std::vector<std::pair<size_t, Utils::Coordinate>>{};
+  for (auto route = size_t{}; route < routes.size(); ++route)
+    for (const auto unit : routes[route].units) units.emplace_back(route, unit);
+
+  auto paths = std::vector<std::vector<Utils::Coordinate>>(units.size());
+  Utils::parallelFor(units.size(), threads, [&](size_t index) {
+    const auto [route, unit] = units[index];
+    const auto target        = routes[route].target;
+    if (!floods[route]) {
+      paths[index] = unitPath(unit, target, passable);
+      return;
+    }
+
+    const auto previous = floods[route]->pathMap(0);
+    if (previous.contains(unit))
+      paths[index] = path_finder::tracePath(previous, unit, target);
+  });
+
+  auto result =
+      std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>{};
+  for (auto index = size_t{}; index < units.size(); ++index) {
+    if (paths[index].empty()) continue;
+    result[units[index].second] = std::move(paths[index]);
+  }
+  return result;
+}
+
+}  // namespace
 
 namespace path_finder {
 
@@ -16,27 +304,56 @@ namespace path_finder {
 // findPath() returns a path from any grid coordinate that can reach the
 // specified target.
 //
+template <typename ENGINE, typename NEIGHBORHOOD>
 [[nodiscard]] auto findPath(const tilemap::Grid& grid, Utils::Coordinate target)
-    -> std::unordered_map<Utils::Coordinate,
-                          std::unordered_set<Utils::Coordinate>> {
-  // adjacent() returns all non-elevated orthogonal neighbors of the given
-  // coordinate position. The distance to all orthogonal neighobors is set to 1.
-  const auto adjacent = [&](const auto& from) {
-    return from.neighborsUpDownLeftRight()  //
-           | std::views::filter([&](auto pos) {
-               return grid.inBounds(pos) and
-                      grid[pos] != tilemap::woodland::FORREST;
-             })  //
-           | std::views::transform(
-                 [](auto pos) { return Dijkstra::Edge{1, pos}; })  //
-           | std::ranges::to<std::vector>();
-  };
+    -> typename ENGINE::PathMap {
+  const auto costs = terrainCostsOf(grid);
+  const auto adjacent =
+      adjacentTo<typename ENGINE::Edge, NEIGHBORHOOD>(passableOn(costs));
 
   // The Dijkstra's path finding algorithm returns a pair of distances for each
   // graph node as well as the path to the target from each node. Since we don't
   // need the cost, the first return value is ignored.
-  const auto& [_, previous] = Dijkstra::find({0, target}, adjacent);
-  return previous;
+  if constexpr (std::is_same_v<ENGINE, GridDijkstra>) {
+    // The flat maps cannot hold a target outside the grid
+    if (!grid.inBounds(target))
+      return typename ENGINE::PathMap{grid.width(), grid.height()};
+    return ENGINE::find(grid.width(), grid.height(), {0, target}, adjacent)
+        .second;
+  } else {
+    return ENGINE::find({0, target}, adjacent).second;
+  }
+}
+
+template auto findPath<Dijkstra, Neighborhood::FourConnected>(
+    const tilemap::Grid& grid, Utils::Coordinate target) -> Dijkstra::PathMap;
+template auto findPath<Dijkstra, Neighborhood::EightConnected>(
+    const tilemap::Grid& grid, Utils::Coordinate target) -> Dijkstra::PathMap;
+template auto findPath<Dijkstra, Neighborhood::Octile>(
+    const tilemap::Grid& grid, Utils::Coordinate target) -> Dijkstra::PathMap;
+template auto findPath<GridDijkstra, Neighborhood::FourConnected>(
+    const tilemap::Grid& grid, Utils::Coordinate target)
+    -> GridDijkstra::PathMap;
+template auto findPath<GridDijkstra, Neighborhood::EightConnected>(
+    const tilemap::Grid& grid, Utils::Coordinate target)
+    -> GridDijkstra::PathMap;
+template auto findPath<GridDijkstra, Neighborhood::Octile>(
+    const tilemap::Grid& grid, Utils::Coordinate target)
+    -> GridDijkstra::PathMap;
+
+//
+// findPath() variant that runs the GridDijkstra search within a reusable
+// |context|.
+//
+[[nodiscard]] auto findPath(const tilemap::Grid& grid, Utils::Coordinate target,
+                            SearchContext& context) -> const SearchContext& {
+  // A target outside the grid leaves the context without any path
+  if (!grid.inBounds(target)) {
+    context.reset(grid.width(), grid.height());
+    return context;
+  }
+  return GridDijkstra::find(context, grid.width(), grid.height(), {0, target},
+                            adjacentTo<GridDijkstra::Edge>(grid));
 }
 
 //
@@ -54,25 +371,263 @@ namespace path_finder {
   return path;
 }
 
+//
+// findUnitPath() returns the path for a single unit to its target using the A*
+// algorithm, or an empty vector if the unit cannot reach the target.
+//
+[[nodiscard]] auto findUnitPath(const tilemap::Grid& grid,
+                                Utils::Coordinate unit,
+                                Utils::Coordinate target)
+    -> std::vector<Utils::Coordinate> {
+  return unitPath(unit, target,
+                  [&](auto pos) { return isPassable(grid, pos); });
+}
+
+//
+// findUnitPath() variant that runs the A* search within a reusable |context|.
+//
+[[nodiscard]] auto findUnitPath(const tilemap::Grid& grid,
+                                Utils::Coordinate unit,
+                                Utils::Coordinate target,
+                                SearchContext& context)
+    -> std::vector<Utils::Coordinate> {
+  if (!grid.inBounds(target)) return {};
+  const auto heuristic = [&](const auto& from) {
+    return from.manhattanDistanceFrom(unit);
+  };
+
+  // As for findUnitPath() above, the search runs from the target towards the
+  // unit.
+  const auto& previous = GridAStar::find(
+      context, grid.width(), grid.height(), {0, target}, unit,
+      adjacentTo<GridAStar::Edge>(grid), heuristic);
+  if (!previous.contains(unit)) return {};
+  return tracePath(previous, unit, target);
+}
+
+//
+// findBidirectionalPath() returns the path for a single unit to its target
+// using bidirectional Dijkstra's algorithm.
+//
+[[nodiscard]] auto findBidirectionalPath(const tilemap::Grid& grid,
+                                         Utils::Coordinate unit,
+                                         Utils::Coordinate target)
+    -> std::vector<Utils::Coordinate> {
+  if (!isPassable(grid, unit) or !isPassable(grid, target)) return {};
+  return Bidirectional::find(unit, target,
+                             adjacentTo<Bidirectional::Edge>(grid));
+}
+
+//
+// findBidirectionalUnitPath() returns the path for a single unit to its target
+// using the bidirectional A* algorithm.
+//
+[[nodiscard]] auto findBidirectionalUnitPath(const tilemap::Grid& grid,
+                                             Utils::Coordinate unit,
+                                             Utils::Coordinate target)
+    -> std::vector<Utils::Coordinate> {
+  if (!isPassable(grid, unit) or !isPassable(grid, target)) return {};
+  const auto heuristic = [](const auto& from, const auto& to) {
+    return from.manhattanDistanceFrom(to);
+  };
+  return Bidirectional::find(
+      unit, target, adjacentTo<Bidirectional::Edge>(grid), heuristic);
+}
+
+//
+// findJumpPointPath() returns the path for a single unit to its target using
+// Jump Point Search, or an empty vector if the unit cannot reach the target.
+//
+[[nodiscard]] auto findJumpPointPath(const tilemap::Grid& grid,
+                                     Utils::Coordinate unit,
+                                     Utils::Coordinate target)
+    -> std::vector<Utils::Coordinate> {
+  return JumpPointSearch::find(
+      unit, target, [&](auto pos) { return isPassable(grid, pos); });
+}
+
+//
+// passabilityOf() returns a bitmap of all grid positions a unit can travel
+// across.
+//
+[[nodiscard]] auto passabilityOf(const tilemap::Grid& grid) -> Utils::BitGrid {
+  return Utils::BitGrid::from(grid.width(), grid.height(), [&](auto pos) {
+    return isPassable(grid, pos);
+  });
+}
+
+//
+// passabilityOf() variant operating on the compact grid representation.
+//
+[[nodiscard]] auto passabilityOf(const tilemap::CompactGrid& grid)
+    -> Utils::BitGrid {
+  return Utils::BitGrid::from(grid.width(), grid.height(),
+                              [&](auto pos) { return grid.passable(pos); });
+}
+
+//
+// terrainCostsOf() returns the cost of entering every grid position.
+//
+[[nodiscard]] auto terrainCostsOf(const tilemap::Grid& grid)
+    -> Utils::CostGrid {
+  return Utils::CostGrid::from(grid.width(), grid.height(), [&](auto pos) {
+    return tilemap::woodland::terrainCost(grid[pos]);
+  });
+}
+
+//
+// terrainCostsOf() variant operating on the compact grid representation, which
+// looks up the cost of every position in the palette property table.
+//
+[[nodiscard]] auto terrainCostsOf(const tilemap::CompactGrid& grid)
+    -> Utils::CostGrid {
+  return Utils::CostGrid::from(grid.width(), grid.height(), [&](auto pos) {
+    return grid.properties(pos).cost;
+  });
+}
+
+//
+// findWeightedPath() returns a path from any grid coordinate that can reach the
+// specified target, on weighted terrain.
+//
+template <typename NEIGHBORHOOD>
+[[nodiscard]] auto findWeightedPath(const Utils::CostGrid& costs,
+                                    Utils::Coordinate target)
+    -> GridDijkstra::PathMap {
+  return WeightedDijkstra::find(
+             costs.width(), costs.height(), {0, target},
+             adjacentTo<WeightedDijkstra::Edge, NEIGHBORHOOD>(costs))
+      .second;
+}
+
+template auto findWeightedPath<Neighborhood::FourConnected>(
+    const Utils::CostGrid& costs, Utils::Coordinate target)
+    -> GridDijkstra::PathMap;
+template auto findWeightedPath<Neighborhood::EightConnected>(
+    const Utils::CostGrid& costs, Utils::Coordinate target)
+    -> GridDijkstra::PathMap;
+template auto findWeightedPath<Neighborhood::Octile>(
+    const Utils::CostGrid& costs, Utils::Coordinate target)
+    -> GridDijkstra::PathMap;
+
+//
+// findDistanceField() returns the distance to the specified target from every
+// grid coordinate that can reach it.
+//
+[[nodiscard]] auto findDistanceField(const tilemap::Grid& grid,
+                                     Utils::Coordinate target)
+    -> Utils::DistanceField {
+  return Utils::BitBfs::find(passabilityOf(grid), target);
+}
+
+//
+// buildHierarchy() precomputes the cluster abstraction of the |grid| used for
+// hierarchical path finding.
+//
+[[nodiscard]] auto buildHierarchy(const tilemap::Grid& grid)
+    -> Utils::HierarchicalAStar {
+  return Utils::HierarchicalAStar{passabilityOf(grid), CLUSTER_SIZE};
+}
+
+//
+// unitPlanner() returns an incremental path planner for a single unit and its
+// target.
+//
+[[nodiscard]] auto unitPlanner(const tilemap::Grid& grid,
+                               Utils::Coordinate unit,
+                               Utils::Coordinate target) -> Utils::DStarLite {
+  return Utils::DStarLite{passabilityOf(grid), unit, target};
+}
+
 //
 // unitPaths() returns a path for each unit that can reach its matching target
 //
 [[nodiscard]] auto unitPaths(const tilemap::Grid& grid)
     -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>> {
-  auto routes =
-      std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>{};
-  for (const auto& route : tilemap::woodland::UNIT_TARGETS) {
-    const auto maybe_target = grid.find(route.target_tile);
-    if (!maybe_target) continue;
+  return unitPaths(grid, tilemap::TileIndex{grid});
+}
 
-    const auto previous = findPath(grid, *maybe_target);
+//
+// unitPaths() variant that locates units and targets through the tile |index|.
+//
+[[nodiscard]] auto unitPaths(const tilemap::Grid& grid,
+                             const tilemap::TileIndex& index)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>> {
+  return routeUnits<std::vector<Utils::Coordinate>>(grid, index);
+}
 
-    for (const auto& unit_start : grid.findAll(route.unit_tile)) {
-      if (!previous.contains(unit_start)) continue;
-      routes[unit_start] = tracePath(previous, unit_start, *maybe_target);
-    }
-  }
-  return routes;
+//
+// unitPaths() variant operating on the compact grid representation.
+//
+[[nodiscard]] auto unitPaths(const tilemap::CompactGrid& grid)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>> {
+  return routeUnits<std::vector<Utils::Coordinate>>(grid);
+}
+
+[[nodiscard]] auto unitPaths(const tilemap::CompactGrid& grid,
+                             const tilemap::TileIndex& index)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>> {
+  return routeUnits<std::vector<Utils::Coordinate>>(grid, index);
+}
+
+//
+// compactUnitPaths() returns the unitPaths() result in compact form.
+//
+[[nodiscard]] auto compactUnitPaths(const tilemap::Grid& grid)
+    -> std::unordered_map<Utils::Coordinate, CompactPath> {
+  return compactUnitPaths(grid, tilemap::TileIndex{grid});
+}
+
+[[nodiscard]] auto compactUnitPaths(const tilemap::Grid& grid,
+                                    const tilemap::TileIndex& index)
+    -> std::unordered_map<Utils::Coordinate, CompactPath> {
+  return routeUnits<CompactPath>(grid, index);
+}
+
+//
+// compactUnitPaths() variant operating on the compact grid representation.
+//
+[[nodiscard]] auto compactUnitPaths(const tilemap::CompactGrid& grid)
+    -> std::unordered_map<Utils::Coordinate, CompactPath> {
+  return routeUnits<CompactPath>(grid);
+}
+
+[[nodiscard]] auto compactUnitPaths(const tilemap::CompactGrid& grid,
+                                    const tilemap::TileIndex& index)
+    -> std::unordered_map<Utils::Coordinate, CompactPath> {
+  return routeUnits<CompactPath>(grid, index);
+}
+
+//
+// unitPaths() variant that spreads the work across up to |threads| worker
+// threads.
+//
+[[nodiscard]] auto unitPaths(const tilemap::Grid& grid, size_t threads)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>> {
+  return unitPaths(grid, tilemap::TileIndex{grid}, threads);
+}
+
+//
+// unitPaths() variant that spreads the work across up to |threads| worker
+// threads, locating units and targets through the tile |index|.
+//
+[[nodiscard]] auto unitPaths(const tilemap::Grid& grid,
+                             const tilemap::TileIndex& index, size_t threads)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>> {
+  const auto costs = terrainCostsOf(grid);
+  return routeUnitsInParallel(grid.width(), grid.height(), index, threads,
+                              passableOn(costs));
+}
+
+//
+// unitPaths() variant that spreads the work across up to |threads| worker
+// threads, operating on the compact grid representation.
+//
+[[nodiscard]] auto unitPaths(const tilemap::CompactGrid& grid,
+                             const tilemap::TileIndex& index, size_t threads)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>> {
+  return routeUnitsInParallel(grid.width(), grid.height(), index, threads,
+                              [&](auto pos) { return grid.passable(pos); });
 }
 
 }  // namespace path_finder
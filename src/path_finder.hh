@@ -1,25 +1,105 @@
 #ifndef PATH_FINDER_HH
 #define PATH_FINDER_HH
 
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "src/tilemap.hh"
+#include "src/tilemap_palette.hh"
+#include "src/tilemap_woodland.hh"
+#include "utils/astar.hh"
+#include "utils/bidirectional.hh"
+#include "utils/bit_grid.hh"
+#include "utils/bucket_queue.hh"
+#include "utils/compact_path.hh"
 #include "utils/coordinate.hh"
+#include "utils/cost_grid.hh"
+#include "utils/d_star_lite.hh"
 #include "utils/dijkstras.hh"
+#include "utils/distance_field.hh"
+#include "utils/flat_hash_map.hh"
+#include "utils/grid_dijkstra.hh"
+#include "utils/hierarchical_astar.hh"
+#include "utils/jump_point_search.hh"
+#include "utils/label_flood.hh"
+#include "utils/neighborhood.hh"
+#include "utils/radix_heap.hh"
+#include "utils/search_context.hh"
 
 namespace path_finder {
 
-using Dijkstra = Utils::Dijkstra<int, Utils::Coordinate>;
+// All edges on the tile map have a cost of 1, so the grid based engines use a
+// bucket queue for O(1) frontier operations. The hash map based engines use
+// flat, open-addressing hash containers.
+using HashContainers = Utils::FlatHashContainers;
+
+using AStar        = Utils::AStar<int, Utils::Coordinate, Utils::BucketQueue,
+                                  HashContainers>;
+using Dijkstra     = Utils::Dijkstra<int, Utils::Coordinate,
+                                     Utils::PriorityQueue, HashContainers>;
+using GridDijkstra = Utils::GridDijkstra<int, Utils::BucketQueue>;
+using GridAStar    = Utils::GridAStar<int, Utils::BucketQueue>;
+using Bidirectional =
+    Utils::BidirectionalSearch<int, Utils::Coordinate, Utils::BucketQueue,
+                               HashContainers>;
+
+// Edge costs on weighted terrain range up to 14 * 254 per step (see
+// findWeightedPath()), so the weighted search uses a radix heap, which does
+// not need a bucket per distance in that range.
+using WeightedDijkstra = Utils::GridDijkstra<int, Utils::RadixHeap>;
+
+// Reusable working storage of the grid based engines (see findPath() and
+// findUnitPath() below)
+using SearchContext = Utils::SearchContext<int, Utils::BucketQueue>;
+
+// Units only travel orthogonally across the tile map.
+using JumpPointSearch = Utils::JumpPointSearch<Utils::Movement::Orthogonal>;
+
+// Cluster size (in tiles) of the hierarchical path finder.
+constexpr auto CLUSTER_SIZE = size_t{16};
+
+// One flood label per unit/target color
+using LabelFlood = Utils::LabelFlood<tilemap::woodland::UNIT_TARGETS.size()>;
+
+// Neighborhood policies (see Utils::NeighborhoodPolicy)
+namespace Neighborhood = Utils::Neighborhood;
 
 //
 // findPath() returns a path from any grid coordinate that can reach the
 // specified target.
 //
+// The search ENGINE can be either the generic, hash map based Dijkstra or the
+// flat array based GridDijkstra (default). The NEIGHBORHOOD selects how units
+// travel across the map; orthogonally (FourConnected, default), or diagonally
+// as well (EightConnected or Octile).
+//
+template <typename ENGINE = GridDijkstra,
+          typename NEIGHBORHOOD = Neighborhood::FourConnected>
 [[nodiscard]] auto findPath(const tilemap::Grid& grid, Utils::Coordinate target)
-    -> std::unordered_map<Utils::Coordinate,
-                          std::unordered_set<Utils::Coordinate>>;
+    -> typename ENGINE::PathMap;
+
+//
+// findPath() variant that runs the GridDijkstra search within a reusable
+// |context|. Once the context has warmed up, repeated searches on the same grid
+// perform no heap allocations:
+//
+//   auto context = SearchContext{};
+//   for (const auto target : targets) {
+//     const auto& previous = findPath(grid, target, context);
+//     ...
+//   }
+//
+// The returned path map is the |context| itself, and remains valid until its
+// next search.
+//
+[[nodiscard]] auto findPath(const tilemap::Grid& grid, Utils::Coordinate target,
+                            SearchContext& context) -> const SearchContext&;
 
 //
 // tracePath() returns a path for a given unit (if it can reach its target) or
@@ -29,12 +109,370 @@ using Dijkstra = Utils::Dijkstra<int, Utils::Coordinate>;
                              Utils::Coordinate unit, Utils::Coordinate target)
     -> std::vector<Utils::Coordinate>;
 
+//
+// SinglePathMap describes previous maps that hold a single predecessor per
+// grid position, such as GridDijkstra::PathMap or LabelFlood::PathMap.
+//
+template <typename PATH_MAP>
+concept SinglePathMap =
+    requires(const PATH_MAP& previous, Utils::Coordinate position) {
+      { previous.contains(position) } -> std::convertible_to<bool>;
+      { previous.at(position) } -> std::convertible_to<Utils::Coordinate>;
+    };
+
+template <SinglePathMap PATH_MAP>
+[[nodiscard]] auto tracePath(const PATH_MAP& previous, Utils::Coordinate unit,
+                             Utils::Coordinate target)
+    -> std::vector<Utils::Coordinate> {
+  auto path = std::vector<Utils::Coordinate>{unit};
+  while (previous.contains(unit) and unit != target) {
+    unit = previous.at(unit);
+    path.push_back(unit);
+  }
+  return path;
+}
+
+// Paths held in compact form (see traceCompactPath())
+using CompactPath = Utils::CompactPath<Utils::Movement::Orthogonal>;
+
+//
+// traceCompactPath() returns the tracePath() result in compact form, storing
+// two bits per step rather than a full coordinate. The path is traced directly
+// into its compact form.
+//
+template <SinglePathMap PATH_MAP>
+[[nodiscard]] auto traceCompactPath(const PATH_MAP& previous,
+                                    Utils::Coordinate unit,
+                                    Utils::Coordinate target) -> CompactPath {
+  auto path = CompactPath{unit};
+  while (previous.contains(unit) and unit != target) {
+    unit = previous.at(unit);
+    path.push_back(unit);
+  }
+  return path;
+}
+
+//
+// PathView<> provides a lazy view of the tracePath() result, which walks the
+// |previous| map one step at a time as it is iterated, rather than
+// materializing the path.
+//
+// The view refers to the |previous| map, which must outlive it.
+//
+template <SinglePathMap PATH_MAP>
+class PathView {
+  const PATH_MAP* previous_{};
+  Utils::Coordinate unit_{};
+  Utils::Coordinate target_{};
+
+ public:
+  class Iterator {
+    const PathView* view_{};
+    std::optional<Utils::Coordinate> current_{};
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Utils::Coordinate;
+    using difference_type   = std::ptrdiff_t;
+
+    [[nodiscard]] constexpr Iterator() = default;
+
+    [[nodiscard]] constexpr Iterator(const PathView* view,
+                                     std::optional<Utils::Coordinate> current)
+        : view_{view}, current_{current} {}
+
+    [[nodiscard]] constexpr auto operator*() const -> Utils::Coordinate {
+      return *current_;
+    }
+
+    constexpr auto operator++() -> Iterator& {
+      if (*current_ == view_->target_ or !view_->previous_->contains(*current_))
+        current_ = std::nullopt;
+      else
+        current_ = view_->previous_->at(*current_);
+      return *this;
+    }
+
+    constexpr auto operator++(int) -> Iterator {
+      auto previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const Iterator& other) const
+        -> bool {
+      return current_ == other.current_;
+    }
+  };
+
+  [[nodiscard]] constexpr PathView(const PATH_MAP& previous,
+                                   Utils::Coordinate unit,
+                                   Utils::Coordinate target)
+      : previous_{&previous}, unit_{unit}, target_{target} {}
+
+  [[nodiscard]] constexpr auto begin() const { return Iterator{this, unit_}; }
+  [[nodiscard]] constexpr auto end() const {
+    return Iterator{this, std::nullopt};
+  }
+};
+
+//
+// tracePathView() returns a lazy view of the tracePath() result (see
+// PathView<>).
+//
+template <SinglePathMap PATH_MAP>
+[[nodiscard]] auto tracePathView(const PATH_MAP& previous,
+                                 Utils::Coordinate unit,
+                                 Utils::Coordinate target)
+    -> PathView<PATH_MAP> {
+  return {previous, unit, target};
+}
+
+//
+// PathCursor<> tracks the progress of a unit along its |path| (ex. a
+// CompactPath or a PathView<>), so advancing the unit by one step takes O(1)
+// time regardless of the path length.
+//
+// The cursor refers to the |path|, which must outlive it.
+//
+template <std::ranges::forward_range PATH>
+class PathCursor {
+  std::ranges::iterator_t<const PATH> current_;
+  std::ranges::sentinel_t<const PATH> end_;
+
+ public:
+  [[nodiscard]] explicit PathCursor(const PATH& path)
+      : current_{std::ranges::begin(path)}, end_{std::ranges::end(path)} {}
+
+  // Returns true once the unit has advanced past the end of its path
+  [[nodiscard]] constexpr auto done() const -> bool { return current_ == end_; }
+
+  // Only valid if done() returns false.
+  [[nodiscard]] constexpr auto position() const -> Utils::Coordinate {
+    return *current_;
+  }
+
+  // Returns the next position along the path, or std::nullopt if the unit has
+  // reached the end of its path.
+  [[nodiscard]] constexpr auto next() const
+      -> std::optional<Utils::Coordinate> {
+    if (done()) return std::nullopt;
+    const auto next = std::ranges::next(current_);
+    if (next == end_) return std::nullopt;
+    return *next;
+  }
+
+  constexpr void advance() { ++current_; }
+};
+
+//
+// findUnitPath() returns the path for a single unit to its target using the A*
+// algorithm, or an empty vector if the unit cannot reach the target.
+//
+// Only the part of the map between the unit and its target is explored, which
+// makes this preferable to findPath() when only a single path is needed.
+//
+[[nodiscard]] auto findUnitPath(const tilemap::Grid& grid,
+                                Utils::Coordinate unit,
+                                Utils::Coordinate target)
+    -> std::vector<Utils::Coordinate>;
+
+//
+// findUnitPath() variant that runs the A* search within a reusable |context|
+// (see findPath()). Only the returned path is allocated.
+//
+// The path has the same length as the findUnitPath() result above, but may take
+// a different route where several shortest paths exist.
+//
+[[nodiscard]] auto findUnitPath(const tilemap::Grid& grid,
+                                Utils::Coordinate unit,
+                                Utils::Coordinate target,
+                                SearchContext& context)
+    -> std::vector<Utils::Coordinate>;
+
+//
+// findBidirectionalPath() returns the path for a single unit to its target
+// using bidirectional Dijkstra's algorithm, or an empty vector if the unit
+// cannot reach the target.
+//
+// The map is searched from both the unit and its target until the searches
+// meet, which explores about half the area of a one-sided search. The path is
+// returned in the same format as tracePath(), and has the same length as the
+// findUnitPath() result (but may take a different route where several
+// shortest paths exist).
+//
+[[nodiscard]] auto findBidirectionalPath(const tilemap::Grid& grid,
+                                         Utils::Coordinate unit,
+                                         Utils::Coordinate target)
+    -> std::vector<Utils::Coordinate>;
+
+//
+// findBidirectionalUnitPath() variant of findBidirectionalPath() that guides
+// both searches towards each other using the bidirectional A* algorithm.
+//
+[[nodiscard]] auto findBidirectionalUnitPath(const tilemap::Grid& grid,
+                                             Utils::Coordinate unit,
+                                             Utils::Coordinate target)
+    -> std::vector<Utils::Coordinate>;
+
+//
+// findJumpPointPath() returns the path for a single unit to its target using
+// Jump Point Search, or an empty vector if the unit cannot reach the target.
+//
+// On large, open maps this expands far fewer nodes than findUnitPath(). The
+// path is returned in full, step-by-step form, just like tracePath().
+//
+[[nodiscard]] auto findJumpPointPath(const tilemap::Grid& grid,
+                                     Utils::Coordinate unit,
+                                     Utils::Coordinate target)
+    -> std::vector<Utils::Coordinate>;
+
+//
+// passabilityOf() returns a bitmap of all grid positions a unit can travel
+// across, with a single bit per tile.
+//
+[[nodiscard]] auto passabilityOf(const tilemap::Grid& grid) -> Utils::BitGrid;
+
+[[nodiscard]] auto passabilityOf(const tilemap::CompactGrid& grid)
+    -> Utils::BitGrid;
+
+//
+// terrainCostsOf() returns the cost of entering every grid position, according
+// to the terrain cost table of the tileset (see woodland::TERRAIN_COSTS).
+//
+// The costs are resolved once per map, so searches on weighted terrain (see
+// findWeightedPath()) read the cost of each neighbor with a single load.
+//
+[[nodiscard]] auto terrainCostsOf(const tilemap::Grid& grid)
+    -> Utils::CostGrid;
+
+[[nodiscard]] auto terrainCostsOf(const tilemap::CompactGrid& grid)
+    -> Utils::CostGrid;
+
+//
+// findWeightedPath() returns a path from any grid coordinate that can reach the
+// specified target, taking the least costly rather than the shortest route
+// across the weighted terrain |costs| (see terrainCostsOf()).
+//
+// The step costs of the NEIGHBORHOOD are multiplied by the cost of the terrain
+// entered. The result can be traced by tracePath() just like the findPath()
+// results.
+//
+template <typename NEIGHBORHOOD = Neighborhood::FourConnected>
+[[nodiscard]] auto findWeightedPath(const Utils::CostGrid& costs,
+                                    Utils::Coordinate target)
+    -> GridDijkstra::PathMap;
+
+//
+// findDistanceField() returns the distance to the specified target from every
+// grid coordinate that can reach it.
+//
+// The search uses a word-parallel breadth-first search over the passability
+// bitmap (see BitBfs), which scales to very large maps. The result can be
+// traced by tracePath() just like the findPath() results.
+//
+[[nodiscard]] auto findDistanceField(const tilemap::Grid& grid,
+                                     Utils::Coordinate target)
+    -> Utils::DistanceField;
+
+//
+// buildHierarchy() precomputes the cluster abstraction of the |grid| used for
+// hierarchical path finding (see Utils::HierarchicalAStar).
+//
+// The result can be reused for any number of path queries on the same grid:
+//
+//   const auto hierarchy = buildHierarchy(grid);
+//   const auto path      = hierarchy.find(unit, target);
+//
+// The path is returned in the same format as tracePath(), but may be slightly
+// longer than the shortest path.
+//
+[[nodiscard]] auto buildHierarchy(const tilemap::Grid& grid)
+    -> Utils::HierarchicalAStar;
+
+//
+// unitPlanner() returns an incremental path planner (see Utils::DStarLite) for
+// a single unit and its target.
+//
+// As the unit advances (moveTo()) or tiles change (update()), the planner
+// repairs the previous search rather than starting over:
+//
+//   auto planner = unitPlanner(grid, unit, target);
+//   auto path    = planner.path();
+//   planner.update(blocked, false);
+//   path = planner.path();
+//
+[[nodiscard]] auto unitPlanner(const tilemap::Grid& grid,
+                               Utils::Coordinate unit,
+                               Utils::Coordinate target) -> Utils::DStarLite;
+
 //
 // unitPaths() returns a path for each unit that can reach its matching target
 //
+// Colors with only a single unit are resolved using findUnitPath(). All other
+// targets are flooded at once, in a single pass over the map (see LabelFlood).
+// Maps loaded in their compact representation (see tilemap::compactFromJson())
+// are searched on the palette property table of the tiles.
+//
+// Units and targets are located through the tile |index| of the map, if given
+// (see tilemap::fromJson()), rather than by scanning the entire map.
+//
 [[nodiscard]] auto unitPaths(const tilemap::Grid& grid)
     -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>;
 
+[[nodiscard]] auto unitPaths(const tilemap::Grid& grid,
+                             const tilemap::TileIndex& index)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>;
+
+[[nodiscard]] auto unitPaths(const tilemap::CompactGrid& grid)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>;
+
+[[nodiscard]] auto unitPaths(const tilemap::CompactGrid& grid,
+                             const tilemap::TileIndex& index)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>;
+
+//
+// compactUnitPaths() returns the unitPaths() result with every path held in
+// compact form (see CompactPath), for maps with very many units.
+//
+// Paths are traced directly into their compact form, so the full coordinate
+// list of a path is never held in memory.
+//
+[[nodiscard]] auto compactUnitPaths(const tilemap::Grid& grid)
+    -> std::unordered_map<Utils::Coordinate, CompactPath>;
+
+[[nodiscard]] auto compactUnitPaths(const tilemap::Grid& grid,
+                                    const tilemap::TileIndex& index)
+    -> std::unordered_map<Utils::Coordinate, CompactPath>;
+
+[[nodiscard]] auto compactUnitPaths(const tilemap::CompactGrid& grid)
+    -> std::unordered_map<Utils::Coordinate, CompactPath>;
+
+[[nodiscard]] auto compactUnitPaths(const tilemap::CompactGrid& grid,
+                                    const tilemap::TileIndex& index)
+    -> std::unordered_map<Utils::Coordinate, CompactPath>;
+
+//
+// unitPaths() variant that spreads the work across up to |threads| worker
+// threads (0 uses all available hardware threads).
+//
+// Each target is flooded separately in parallel, after which the paths of all
+// units are traced in parallel. The result is identical to unitPaths() above.
+//
+// Units and targets are located through a tile index of the |grid|, built in
+// a single pass (or taken from tilemap::fromJson(), see below).
+//
+[[nodiscard]] auto unitPaths(const tilemap::Grid& grid, size_t threads)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>;
+
+[[nodiscard]] auto unitPaths(const tilemap::Grid& grid,
+                             const tilemap::TileIndex& index, size_t threads)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>;
+
+[[nodiscard]] auto unitPaths(const tilemap::CompactGrid& grid,
+                             const tilemap::TileIndex& index, size_t threads)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>;
+
 }  // namespace path_finder
 
 #endif  // PATH_FINDER_HH
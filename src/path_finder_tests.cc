@@ -1,6 +1,10 @@
+#include <array>
+#include <optional>
+
 #include "src/path_finder.hh"
 #include "testrunner/testrunner.h"
 #include "utils/coordinate.hh"
+#include "utils/file_content.hh"
 
 namespace {
 
@@ -20,6 +24,12 @@ constexpr auto TWO_UNITS_TEST_MAP =
 "data":[8.4,-1,0.6,-1,-1,8.4]}],"tilesets":[{"tilewidth":32,"tileheight":32}],
 "canvas":{"width":192,"height":32}})";
 
+constexpr auto OPEN_THREE_BY_THREE_TEST_MAP =
+    R"({"layers":[{"tileset":"MapEditor Tileset_woodland.png",
+"data":[8.4,-1,-1,-1,-1,-1,-1,-1,0.6]}],
+"tilesets":[{"tilewidth":32,"tileheight":32}],
+"canvas":{"width":96,"height":96}})";
+
 }  // namespace
 
 TEST(PathFinder_Finds_single_unobstructed_path) {
@@ -81,3 +91,452 @@ TEST(PathFinder_Finds_paths_for_multiple_units) {
   EXPECT_EQ(unit_paths.at(second_unit).size(), second_expected_path.size());
   EXPECT_EQ(unit_paths.at(second_unit), second_expected_path);
 }
+
+TEST(PathFinder_Grid_and_hash_map_engines_trace_same_path) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto unit          = Utils::Coordinate{};
+  const auto target        = Utils::Coordinate{.x = 4, .y = 4};
+
+  const auto hashed =
+      path_finder::findPath<path_finder::Dijkstra>(grid, target);
+  const auto flat =
+      path_finder::findPath<path_finder::GridDijkstra>(grid, target);
+  ASSERT_TRUE(hashed.contains(unit));
+  ASSERT_TRUE(flat.contains(unit));
+  EXPECT_EQ(path_finder::tracePath(flat, unit, target),
+            path_finder::tracePath(hashed, unit, target));
+}
+
+TEST(PathFinder_Grid_engine_finds_no_path_to_target_outside_the_map) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto target        = Utils::Coordinate{.x = 5, .y = 5};
+  const auto previous =
+      path_finder::findPath<path_finder::GridDijkstra>(grid, target);
+  for (const auto pos : grid.coordinates())
+    ASSERT_FALSE(previous.contains(pos));
+}
+
+TEST(PathFinder_Finds_single_unit_path_with_a_star) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto unit          = Utils::Coordinate{};
+  const auto target        = Utils::Coordinate{.x = 4, .y = 4};
+
+  const auto path = path_finder::findUnitPath(grid, unit, target);
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(path, path_finder::tracePath(path_finder::findPath(grid, target),
+                                         unit, target));
+}
+
+TEST(PathFinder_A_star_returns_empty_path_if_unreachable) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto walled_in     = Utils::Coordinate{.x = 1, .y = 0};  // Forrest
+  const auto path =
+      path_finder::findUnitPath(grid, walled_in, {.x = 4, .y = 4});
+  EXPECT_EQ(path.size(), 0);
+}
+
+TEST(PathFinder_Finds_single_unit_path_with_jump_point_search) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto unit          = Utils::Coordinate{};
+  const auto target        = Utils::Coordinate{.x = 4, .y = 4};
+
+  const auto path = path_finder::findJumpPointPath(grid, unit, target);
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(path, path_finder::tracePath(path_finder::findPath(grid, target),
+                                         unit, target));
+}
+
+TEST(PathFinder_Diagonal_jump_point_search_finds_shortest_path) {
+  using path_finder::GridDijkstra;
+  using DiagonalJumpPointSearch =
+      Utils::JumpPointSearch<Utils::Movement::Diagonal>;
+  namespace Neighborhood = path_finder::Neighborhood;
+
+  for (const auto* map :
+       {OPEN_THREE_BY_THREE_TEST_MAP, FIVE_BY_FIVE_TEST_MAP}) {
+    const auto& maybe_map = tilemap::fromJson(map);
+    ASSERT_TRUE(maybe_map);
+
+    const auto& [info, grid] = *maybe_map;
+    const auto unit          = Utils::Coordinate{};
+    const auto target =
+        Utils::Coordinate{.x = static_cast<int>(grid.width()) - 1,
+                          .y = static_cast<int>(grid.height()) - 1};
+    const auto passable = [&](auto pos) {
+      return grid.inBounds(pos) and grid[pos] != tilemap::woodland::FORREST;
+    };
+
+    const auto path = DiagonalJumpPointSearch::find(unit, target, passable);
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.front(), unit);
+    EXPECT_EQ(path.back(), target);
+    EXPECT_EQ(
+        path.size(),
+        path_finder::tracePath(
+            path_finder::findPath<GridDijkstra, Neighborhood::EightConnected>(
+                grid, target),
+            unit, target)
+            .size());
+
+    // Every step moves to one of the eight neighbors, without cutting corners
+    for (auto step = size_t{1}; step < path.size(); ++step) {
+      const auto from     = path[step - 1];
+      const auto [dx, dy] = path[step] - from;
+      ASSERT_TRUE(std::abs(dx) <= 1 and std::abs(dy) <= 1);
+      ASSERT_TRUE(passable(Utils::Coordinate{.x = from.x, .y = from.y + dy}));
+      ASSERT_TRUE(passable(Utils::Coordinate{.x = from.x + dx, .y = from.y}));
+    }
+  }
+}
+
+TEST(PathFinder_Single_pass_flood_matches_per_target_search) {
+  const auto& maybe_map = tilemap::fromJson(TWO_UNITS_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto target        = Utils::Coordinate{.x = 2, .y = 0};
+
+  auto targets = std::array<std::optional<Utils::Coordinate>,
+                            tilemap::woodland::UNIT_TARGETS.size()>{};
+  targets[1]   = target;
+
+  const auto passable = [&](auto pos) { return grid.inBounds(pos); };
+  const auto flood    = path_finder::LabelFlood::find(
+      grid.width(), grid.height(), targets, passable);
+  const auto previous = path_finder::findPath(grid, target);
+
+  for (const auto unit : {Utils::Coordinate{}, Utils::Coordinate{.x = 5}}) {
+    ASSERT_TRUE(flood.pathMap(1).contains(unit));
+    ASSERT_FALSE(flood.pathMap(0).contains(unit));
+    EXPECT_EQ(path_finder::tracePath(flood.pathMap(1), unit, target),
+              path_finder::tracePath(previous, unit, target));
+  }
+}
+
+TEST(PathFinder_Distance_field_traces_same_path) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto unit          = Utils::Coordinate{};
+  const auto target        = Utils::Coordinate{.x = 4, .y = 4};
+
+  const auto field = path_finder::findDistanceField(grid, target);
+  ASSERT_TRUE(field.contains(unit));
+
+  const auto path = path_finder::tracePath(field, unit, target);
+  EXPECT_EQ(field.distance(unit), path.size() - 1);
+  EXPECT_EQ(path, path_finder::tracePath(path_finder::findPath(grid, target),
+                                         unit, target));
+}
+
+TEST(PathFinder_Parallel_unit_paths_match_sequential_unit_paths) {
+  const auto& maybe_map = tilemap::fromJson(TWO_UNITS_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto expected      = path_finder::unitPaths(grid);
+  ASSERT_FALSE(expected.empty());
+  for (const auto threads : {1U, 2U, 0U}) {
+    const auto paths = path_finder::unitPaths(grid, threads);
+    EXPECT_EQ(paths.size(), expected.size());
+    for (const auto& [unit, path] : paths) {
+      ASSERT_TRUE(expected.contains(unit));
+      EXPECT_EQ(path, expected.at(unit));
+    }
+  }
+}
+
+TEST(PathFinder_Hierarchical_path_finder_reaches_target) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto unit          = Utils::Coordinate{};
+  const auto target        = Utils::Coordinate{.x = 4, .y = 4};
+  const auto shortest =
+      path_finder::tracePath(path_finder::findPath(grid, target), unit, target);
+
+  // A single cluster covers the entire map
+  EXPECT_EQ(path_finder::buildHierarchy(grid).find(unit, target).size(),
+            shortest.size());
+
+  // Multiple clusters; the path may cross cluster borders at entrances only
+  const auto hierarchy =
+      Utils::HierarchicalAStar{path_finder::passabilityOf(grid), 2};
+  const auto path = hierarchy.find(unit, target);
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(path.front(), unit);
+  EXPECT_EQ(path.back(), target);
+  ASSERT_TRUE(path.size() >= shortest.size());
+
+  ASSERT_TRUE(hierarchy.find(unit, {.x = 1, .y = 0}).empty());  // Forrest
+}
+
+TEST(PathFinder_Unit_planner_replans_around_changed_tiles) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto unit          = Utils::Coordinate{};
+  const auto target        = Utils::Coordinate{.x = 4, .y = 4};
+
+  auto planner = path_finder::unitPlanner(grid, unit, target);
+  EXPECT_EQ(planner.path(), path_finder::findUnitPath(grid, unit, target));
+
+  // Blocking the only passage leaves the target unreachable
+  planner.update({.x = 2, .y = 2}, false);
+  ASSERT_TRUE(planner.path().empty());
+
+  // Unblocking it again, after the unit advanced, restores the path
+  planner.update({.x = 2, .y = 2}, true);
+  planner.moveTo({.x = 0, .y = 3});
+  const auto path = planner.path();
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(path.front(), (Utils::Coordinate{.x = 0, .y = 3}));
+  EXPECT_EQ(path.size(), 10);
+}
+
+TEST(PathFinder_Incremental_planner_rejects_targets_outside_the_map) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  for (const auto target : {Utils::Coordinate{.x = 5, .y = 4},
+                            Utils::Coordinate{.x = -1, .y = 0}}) {
+    auto planner = path_finder::unitPlanner(grid, {}, target);
+    ASSERT_TRUE(planner.path().empty());
+  }
+}
+
+TEST(PathFinder_Search_context_is_reusable_across_searches) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto unit          = Utils::Coordinate{};
+
+  auto context = path_finder::SearchContext{};
+  for (const auto target : grid.coordinates()) {
+    const auto fresh    = path_finder::findPath(grid, target);
+    const auto& reused  = path_finder::findPath(grid, target, context);
+    const auto expected = path_finder::tracePath(fresh, unit, target);
+    EXPECT_EQ(reused.contains(unit), fresh.contains(unit));
+    EXPECT_EQ(path_finder::tracePath(reused, unit, target), expected);
+
+    const auto path = path_finder::findUnitPath(grid, unit, target, context);
+    const auto shortest = path_finder::findUnitPath(grid, unit, target);
+    EXPECT_EQ(path.size(), shortest.size());
+  }
+}
+
+TEST(PathFinder_Search_context_holds_no_path_to_target_outside_the_map) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  auto context             = path_finder::SearchContext{};
+
+  // Paths found by an earlier search are forgotten as well
+  ASSERT_TRUE(
+      path_finder::findPath(grid, {.x = 4, .y = 4}, context).contains({}));
+  for (const auto target : {Utils::Coordinate{.x = 5, .y = 0},
+                            Utils::Coordinate{.x = 0, .y = -1}}) {
+    const auto& previous = path_finder::findPath(grid, target, context);
+    for (const auto pos : grid.coordinates())
+      ASSERT_FALSE(previous.contains(pos));
+  }
+}
+
+TEST(PathFinder_Compact_unit_paths_match_unit_paths) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid]  = *maybe_map;
+  const auto& unit_paths    = path_finder::unitPaths(grid);
+  const auto& compact_paths = path_finder::compactUnitPaths(grid);
+  EXPECT_EQ(compact_paths.size(), unit_paths.size());
+
+  for (const auto& [unit, path] : unit_paths) {
+    ASSERT_TRUE(compact_paths.contains(unit));
+    const auto& compact_path = compact_paths.at(unit);
+    EXPECT_EQ(compact_path.size(), path.size());
+    EXPECT_EQ(std::vector<Utils::Coordinate>(compact_path.begin(),
+                                             compact_path.end()),
+              path);
+    EXPECT_EQ(compact_path, path_finder::CompactPath::from(path));
+  }
+
+  // Maps loaded in compact form yield the same paths
+  auto index               = tilemap::TileIndex{};
+  const auto maybe_compact =
+      tilemap::compactFromJson(FIVE_BY_FIVE_TEST_MAP, index);
+  ASSERT_TRUE(maybe_compact);
+
+  const auto& compact_grid = maybe_compact->second;
+  EXPECT_EQ(path_finder::unitPaths(compact_grid), unit_paths);
+  EXPECT_EQ(path_finder::unitPaths(compact_grid, index, 2), unit_paths);
+  EXPECT_EQ(path_finder::compactUnitPaths(compact_grid), compact_paths);
+
+  // Units and targets can be located through the tile index instead
+  EXPECT_EQ(path_finder::unitPaths(grid, index), unit_paths);
+  EXPECT_EQ(path_finder::unitPaths(compact_grid, index), unit_paths);
+  EXPECT_EQ(path_finder::compactUnitPaths(grid, index), compact_paths);
+  EXPECT_EQ(path_finder::compactUnitPaths(compact_grid, index), compact_paths);
+}
+
+TEST(PathFinder_Path_view_and_cursor_walk_traced_path) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto unit          = Utils::Coordinate{};
+  const auto target        = Utils::Coordinate{.x = 4, .y = 4};
+
+  const auto previous = path_finder::findPath(grid, target);
+  const auto path     = path_finder::tracePath(previous, unit, target);
+  const auto view     = path_finder::tracePathView(previous, unit, target);
+  EXPECT_EQ(std::vector<Utils::Coordinate>(view.begin(), view.end()), path);
+
+  auto cursor = path_finder::PathCursor{view};
+  for (auto step = size_t{}; step + 1 < path.size(); ++step) {
+    ASSERT_FALSE(cursor.done());
+    EXPECT_EQ(cursor.position(), path[step]);
+    EXPECT_EQ(cursor.next(), std::optional{path[step + 1]});
+    cursor.advance();
+  }
+  EXPECT_EQ(cursor.position(), target);
+  ASSERT_FALSE(cursor.next());
+  cursor.advance();
+  ASSERT_TRUE(cursor.done());
+}
+
+TEST(PathFinder_Diagonal_neighborhoods_find_shorter_paths) {
+  const auto& maybe_map = tilemap::fromJson(OPEN_THREE_BY_THREE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto unit          = Utils::Coordinate{};
+  const auto target        = Utils::Coordinate{.x = 2, .y = 2};
+
+  using path_finder::GridDijkstra;
+  namespace Neighborhood = path_finder::Neighborhood;
+
+  const auto orthogonal = path_finder::findPath<GridDijkstra>(grid, target);
+  const auto diagonal =
+      path_finder::findPath<GridDijkstra, Neighborhood::EightConnected>(
+          grid, target);
+  const auto octile =
+      path_finder::findPath<GridDijkstra, Neighborhood::Octile>(grid, target);
+
+  EXPECT_EQ(path_finder::tracePath(orthogonal, unit, target).size(), 5);
+  EXPECT_EQ(path_finder::tracePath(diagonal, unit, target).size(), 3);
+  EXPECT_EQ(path_finder::tracePath(octile, unit, target).size(), 3);
+}
+
+TEST(PathFinder_Diagonal_neighborhoods_do_not_cut_corners) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto unit          = Utils::Coordinate{};
+  const auto target        = Utils::Coordinate{.x = 4, .y = 4};
+
+  using path_finder::GridDijkstra;
+  namespace Neighborhood = path_finder::Neighborhood;
+
+  const auto path = path_finder::tracePath(
+      path_finder::findPath<GridDijkstra, Neighborhood::EightConnected>(
+          grid, target),
+      unit, target);
+  EXPECT_EQ(path.back(), target);
+
+  // Every step moves to one of the eight neighbors, without cutting corners
+  for (auto step = size_t{1}; step < path.size(); ++step) {
+    const auto from       = path[step - 1];
+    const auto [dx, dy]   = path[step] - from;
+    const auto vertical   = Utils::Coordinate{.x = from.x, .y = from.y + dy};
+    const auto horizontal = Utils::Coordinate{.x = from.x + dx, .y = from.y};
+    ASSERT_TRUE(std::abs(dx) <= 1 and std::abs(dy) <= 1);
+    ASSERT_TRUE(grid[vertical] != tilemap::woodland::FORREST);
+    ASSERT_TRUE(grid[horizontal] != tilemap::woodland::FORREST);
+  }
+}
+
+TEST(PathFinder_Weighted_path_avoids_costly_terrain) {
+  const auto& maybe_map = tilemap::fromJson(OPEN_THREE_BY_THREE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto unit          = Utils::Coordinate{};
+  const auto target        = Utils::Coordinate{.x = 2, .y = 2};
+  const auto center        = Utils::Coordinate{.x = 1, .y = 1};
+
+  // Uniform terrain yields the same path as findPath()
+  auto costs = path_finder::terrainCostsOf(grid);
+  EXPECT_EQ(
+      path_finder::tracePath(path_finder::findWeightedPath(costs, target),
+                             unit, target),
+      path_finder::tracePath(path_finder::findPath(grid, target), unit,
+                             target));
+
+  // The route through the center is the shortest, but not the cheapest
+  costs.set(center, 10);
+  costs.set({.x = 0, .y = 2}, Utils::CostGrid::IMPASSABLE);
+  const auto path = path_finder::tracePath(
+      path_finder::findWeightedPath(costs, target), unit, target);
+  const auto expected_path = std::vector<Utils::Coordinate>{
+      {.x = 0, .y = 0}, {.x = 1, .y = 0}, {.x = 2, .y = 0}, {.x = 2, .y = 1},
+      {.x = 2, .y = 2}};
+  EXPECT_EQ(path, expected_path);
+}
+
+TEST(PathFinder_Bidirectional_paths_match_unidirectional_paths) {
+  for (const auto* map_file : {"data/5x5.json", "data/jail.json",
+                               "data/map.json", "data/multi_path.json"}) {
+    const auto content = Utils::FileContent::open(map_file);
+    ASSERT_TRUE(content);
+    const auto& maybe_map = tilemap::fromJson(content->text());
+    ASSERT_TRUE(maybe_map);
+
+    const auto& [info, grid] = *maybe_map;
+    for (const auto& route : tilemap::woodland::UNIT_TARGETS) {
+      const auto target = grid.find(route.target_tile);
+      if (!target) continue;
+
+      const auto previous = path_finder::findPath(grid, *target);
+      for (const auto unit : grid.coordinates()) {
+        const auto shortest = path_finder::tracePath(previous, unit, *target);
+        const auto reachable = shortest.back() == *target;
+        for (const auto& path :
+             {path_finder::findBidirectionalPath(grid, unit, *target),
+              path_finder::findBidirectionalUnitPath(grid, unit, *target)}) {
+          if (!reachable) {
+            ASSERT_TRUE(path.empty());
+            continue;
+          }
+          ASSERT_TRUE(path.size() == shortest.size());
+          EXPECT_EQ(path.front(), unit);
+          EXPECT_EQ(path.back(), *target);
+          for (auto step = size_t{1}; step < path.size(); ++step)
+            EXPECT_EQ(path[step].manhattanDistanceFrom(path[step - 1]), 1);
+        }
+      }
+    }
+  }
+}
@@ -1,18 +1,33 @@
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 
+#include <charconv>
+#include <filesystem>
+#include <optional>
 #include <span>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "src/distance_cache.hh"
 #include "src/path_finder.hh"
 #include "src/tilemap.hh"
+#include "src/tilemap_compiled.hh"
+#include "src/tilemap_palette.hh"
+#include "utils/bit_grid.hh"
+#include "utils/coordinate.hh"
 #include "utils/coordinate_formatter.hh"  // IWYU pragma: keep - Used by fmt::print
-#include "utils/read_file.hh"
+#include "utils/file_content.hh"
 
 namespace {
 
-void printAsJson(
-    const std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>&
-        paths) {
+//
+// printAsJson() prints the unit |paths|, held either as coordinate vectors or
+// as path_finder::CompactPath (which is streamed step by step).
+//
+template <typename PATH>
+void printAsJson(const std::unordered_map<Utils::Coordinate, PATH>& paths) {
   auto first = true;
   fmt::print("[\n");
   for (const auto& [from, path] : paths) {
@@ -26,34 +41,199 @@ void printAsJson(
   fmt::print("]\n");
 }
 
-}  // namespace
+//
+// parseThreads() parses the thread count given to the --threads option.
+//
+[[nodiscard]] auto parseThreads(std::string_view text)
+    -> std::optional<size_t> {
+  auto threads         = size_t{};
+  const auto* last     = text.data() + text.size();
+  const auto [ptr, ec] = std::from_chars(text.data(), last, threads);
+  if (ec != std::errc{} or ptr != last) return std::nullopt;
+  return threads;
+}
 
-auto main(int argc, char* argv[]) -> int {
-  const auto args = std::span{argv, static_cast<size_t>(argc)};
-  if (args.size() != 2) {
-    fmt::print(stderr, "Usage: {} <map_file.json>\n", args.front());
-    return 1;
+//
+// Command line options
+//
+struct Options {
+  std::optional<size_t> threads;
+  std::optional<std::filesystem::path> cache;
+  std::optional<tilemap::LayerSelection> layers;
+  std::filesystem::path map_file;
+};
+
+//
+// parseOptions() parses the command line |args|, or returns std::nullopt if
+// they are invalid.
+//
+[[nodiscard]] auto parseOptions(std::span<char*> args)
+    -> std::optional<Options> {
+  if (args.size() < 2) return std::nullopt;
+
+  auto options = Options{
+      .threads = {}, .cache = {}, .layers = {}, .map_file = args.back()};
+  for (auto arg = size_t{1}; arg + 1 < args.size(); arg += 2) {
+    const auto option = std::string_view{args[arg]};
+    if (arg + 2 >= args.size()) return std::nullopt;  // Option value missing
+
+    if (option == "--threads") {
+      options.threads = parseThreads(args[arg + 1]);
+      if (!options.threads) return std::nullopt;
+    } else if (option == "--cache") {
+      options.cache = args[arg + 1];
+    } else if (option == "--layers") {
+      options.layers = tilemap::LayerSelection::parse(args[arg + 1]);
+      if (!options.layers) return std::nullopt;
+    } else {
+      return std::nullopt;
+    }
   }
 
-  const auto json_text = Utils::readFile(args[1]);
-  if (json_text.empty()) {
-    fmt::print(stderr, "Error: Unable to read map from file\n");
-    return 2;
+  if (options.threads and options.cache) {
+    fmt::print(stderr, "Error: --threads and --cache cannot be combined\n");
+    return std::nullopt;
+  }
+  return options;
+}
+
+//
+// printCacheStats() reports the hits, misses and invalidations of the distance
+// field |cache|.
+//
+void printCacheStats(const path_finder::DistanceCache& cache) {
+  const auto& stats = cache.stats();
+  fmt::print(stderr, "Cache: {} hits, {} misses, {} invalidations\n",
+             stats.hits, stats.misses, stats.invalidations);
+}
+
+//
+// findUnitPaths() returns the unit paths using the strategy selected by the
+// command line |options| (--threads or --cache). The |passability| callable
+// returns the passability layer of the map, which only the cache needs.
+//
+[[nodiscard]] auto findUnitPaths(const auto& grid,
+                                 const tilemap::TileIndex& index,
+                                 const Options& options, auto&& passability)
+    -> std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>> {
+  // A thread count of 0 uses all available hardware threads
+  if (options.threads)
+    return path_finder::unitPaths(grid, index, *options.threads);
+
+  auto cache = path_finder::DistanceCache{*options.cache};
+  auto paths = path_finder::unitPaths(passability(), index, cache);
+  printCacheStats(cache);
+  return paths;
+}
+
+//
+// printUnitPaths() prints the unit |paths| and returns the exit code; 4 if no
+// unit can reach its target.
+//
+[[nodiscard]] auto printUnitPaths(const auto& paths) -> int {
+  if (paths.empty()) {
+    fmt::print(stderr,
+               "Error: No units detected or no unit can reach its target\n");
+    return 4;
+  }
+  printAsJson(paths);
+  return 0;
+}
+
+//
+// traceMap() traces the unit paths on the |grid| of a map (either a
+// tilemap::Grid or tilemap::CompactGrid) and its tile |index|, and returns the
+// exit code (see findUnitPaths() for |passability|).
+//
+[[nodiscard]] auto traceMap(const auto& grid, const tilemap::TileIndex& index,
+                            const Options& options, auto&& passability)
+    -> int {
+  // By default, paths are held in compact form, which keeps memory use low for
+  // maps with very many units.
+  if (!options.threads and !options.cache)
+    return printUnitPaths(path_finder::compactUnitPaths(grid, index));
+  return printUnitPaths(findUnitPaths(grid, index, options, passability));
+}
+
+//
+// traceJsonMap() traces the unit paths on a RiskyLab JSON map, and returns the
+// exit code.
+//
+[[nodiscard]] auto traceJsonMap(std::string_view json_text,
+                                const Options& options) -> int {
+  // The tile index is built while decoding the map, so units and targets need
+  // not be searched for afterwards.
+  const auto selected = options.layers.value_or(tilemap::LayerSelection{});
+  auto index          = tilemap::TileIndex{};
+  const auto maybe_tilemap =
+      tilemap::compactFromJson(json_text, index, selected);
+  if (maybe_tilemap) {
+    const auto& grid = maybe_tilemap->second;
+    return traceMap(grid, index, options,
+                    [&] { return path_finder::passabilityOf(grid); });
   }
 
-  const auto maybe_tilemap = tilemap::fromJson(json_text);
-  if (!maybe_tilemap) {
+  // Maps with more distinct tiles than a palette can hold are traced on the
+  // full grid instead
+  const auto maybe_grid = tilemap::fromJson(json_text, index, selected);
+  if (!maybe_grid) {
     fmt::print(stderr, "Error: Unable to parse JSON tilemap\n");
     return 3;
   }
+  const auto& grid = maybe_grid->second;
+  return traceMap(grid, index, options,
+                  [&] { return path_finder::passabilityOf(grid); });
+}
+
+//
+// traceCompiledMap() traces the unit paths on a compiled map (see
+// compile_map), and returns the exit code.
+//
+// The compiled map is searched on its compact grid, passability layer and
+// tile index as loaded.
+//
+[[nodiscard]] auto traceCompiledMap(std::string_view bytes,
+                                    const Options& options) -> int {
+  const auto maybe_map = tilemap::fromCompiledMap(bytes);
+  if (!maybe_map) {
+    fmt::print(stderr, "Error: Unable to load compiled tilemap\n");
+    return 3;
+  }
+
+  const auto& map = *maybe_map;
+  return traceMap(map.grid, map.index, options,
+                  [&]() -> const Utils::BitGrid& { return map.passable; });
+}
+
+}  // namespace
 
-  const auto& [info, grid] = *maybe_tilemap;
-  const auto& unit_paths   = path_finder::unitPaths(grid);
-  if (unit_paths.empty()) {
+auto main(int argc, char* argv[]) -> int {
+  const auto args    = std::span{argv, static_cast<size_t>(argc)};
+  const auto options = parseOptions(args);
+  if (!options) {
     fmt::print(stderr,
-               "Error: No units detected or no unit can reach its target\n");
-    return 4;
+               "Usage: {} [--threads N | --cache DIR] [--layers LAYERS] "
+               "<map_file | ->\n",
+               args.front());
+    return 1;
   }
 
-  printAsJson(unit_paths);
+  // The map file is memory mapped rather than read into a string, and decoded
+  // without a JSON DOM (or not decoded at all, if compiled), so loading large
+  // maps takes little more memory than the resulting grid.
+  const auto map_file = Utils::FileContent::open(options->map_file);
+  if (!map_file or map_file->text().empty()) {
+    fmt::print(stderr, "Error: Unable to read map from file\n");
+    return 2;
+  }
+
+  if (!tilemap::isCompiledMap(map_file->text()))
+    return traceJsonMap(map_file->text(), *options);
+
+  // The layers of a compiled map are selected when compiling it
+  if (options->layers) {
+    fmt::print(stderr, "Error: --layers cannot be used with compiled maps\n");
+    return 1;
+  }
+  return traceCompiledMap(map_file->text(), *options);
 }
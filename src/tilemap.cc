@@ -1,83 +1,482 @@
 #include "src/tilemap.hh"
 
+#include <algorithm>
+#include <charconv>
 #include <optional>
+#include <ranges>
+#include <span>
+#include <string>
 #include <string_view>
+#include <system_error>
 #include <utility>
+#include <vector>
 
-#include "json/json.hh"
+#include "src/tilemap_palette.hh"
+#include "src/tilemap_woodland.hh"
 #include "tilemap_internal.hh"
+#include "utils/json_reader.hh"
 
 namespace tilemap::internal {
 
 //
-// mapInfoFromJson() parses a RiskyLap Online TileMap Editor compatible JSON
-// file and optionally returns a MapInfo object if all values were parsed
-// successfully.
+// readLayerData() decodes the layer data array read by the |reader| straight
+// into the |grid|, storing the cell |to_cell| returns for each tile and
+// invoking |on_tile| with the position and coordinate of each tile. Returns
+// the number of values present in the array.
+//
+template <typename CELL>
+[[nodiscard]] auto readLayerData(Utils::JsonReader& reader,
+                                 Utils::Grid<CELL>& grid, auto&& to_cell,
+                                 auto&& on_tile) -> size_t {
+  const auto width = grid.width();
+  const auto cells = width * grid.height();
+
+  auto values = size_t{};
+  reader.elements([&](size_t index) {
+    const auto text = reader.numberText();
+    const auto tile = text ? coordinateFrom(*text) : Utils::Coordinate{};
+
+    // Excess values are counted, but not stored.
+    values = index + 1;
+    if (index >= cells) return;
+
+    const auto position =
+        Utils::Coordinate{.x = static_cast<int>(index % width),
+                          .y = static_cast<int>(index / width)};
+    grid[position] = to_cell(tile);
+    on_tile(position, tile);
+  });
+  return values;
+}
+
+//
+// DecodedLayer holds a single map layer, decoded into cells of type CELL (ex.
+// tileset coordinates, or palette ids).
+//
+template <typename CELL>
+struct DecodedLayer {
+  size_t position;
+  std::string name;
+  Utils::Grid<CELL> grid;
+};
+
+//
+// mapFromJson() implements layersFromJson(), decoding every tile into the cell
+// returned by |to_cell|, and invoking |on_tile| with the position and
+// coordinate of each tile as the layer data is decoded.
+//
+// The document is read in a single pass (see Utils::JsonReader), without
+// building a JSON DOM or an intermediate list of tiles. Only the canvas size,
+// tilesets[0] and the |selected| layers are read; all other values (including
+// the data of layers that are not selected) are skipped.
+//
+// Layer data is decoded straight into the layer grid if the canvas and tile
+// sizes (and the layer name, if selecting by name) precede it in the document.
+// Otherwise, the position of the data within the |json_text| is remembered, and
+// the data is decoded once the map size is known.
 //
 // NOTE(AE) - This function assumes (BEWARE!) that tilesets[0] has the correct
 // tile widths and heights for the relevant layer and does not attempt to match
 // tileset filenames etc.
 //
-[[nodiscard]] auto mapInfoFromJson(const json::Json& json)
-    -> std::optional<Info> {
+// The same tile size applies to all selected layers.
+//
+template <typename CELL>
+[[nodiscard]] auto mapFromJson(std::string_view json_text,
+                               const LayerSelection& selected, auto&& to_cell,
+                               auto&& on_tile)
+    -> std::optional<std::pair<Info, std::vector<DecodedLayer<CELL>>>> {
+  // Selected layer, along with its data if not decoded yet
+  struct PendingLayer {
+    size_t position;
+    std::string name;
+    std::optional<Utils::Grid<CELL>> grid;
+    std::optional<std::string_view> data;
+    size_t values;
+  };
+
   auto map_info = Info{};
+  auto texture  = std::optional<std::string>{};
+  auto pending  = std::vector<PendingLayer>{};
+
+  auto reader        = Utils::JsonReader{json_text};
+  const auto integer = [&] {
+    return static_cast<int>(reader.number().value_or(0));
+  };
+
+  // Returns the map size (in tiles), once canvas and tile size are known
+  const auto size_in_tiles = [&]() -> std::optional<Utils::Coordinate> {
+    if (map_info.tile_size.x <= 0 or map_info.tile_size.y <= 0)
+      return std::nullopt;
+    const auto tiles_per = map_info.canvas_size / map_info.tile_size;
+    if (tiles_per.x <= 0 or tiles_per.y <= 0) return std::nullopt;
+    return tiles_per;
+  };
+
+  // Decodes the |data| of a |layer| read by |data_reader| into its grid
+  const auto decode = [&](Utils::JsonReader& data_reader, PendingLayer& layer,
+                          Utils::Coordinate tiles_per) {
+    layer.grid.emplace(static_cast<size_t>(tiles_per.x),
+                       static_cast<size_t>(tiles_per.y));
+    layer.values =
+        readLayerData(data_reader, *layer.grid, to_cell, on_tile);
+  };
+
+  const auto read_layer = [&](size_t position) {
+    // Layers selected by name may only be passed over once their name is known.
+    if (!selected.includes(position) and !selected.byName()) {
+      reader.skip();
+      return;
+    }
+
+    auto layer   = PendingLayer{.position = position,
+                                .name     = {},
+                                .grid     = {},
+                                .data     = {},
+                                .values   = {}};
+    auto named   = false;
+    auto tileset = std::optional<std::string>{};
+
+    const auto is_selected = [&] {
+      return selected.includes(position) or
+             (named and selected.includes(position, layer.name));
+    };
 
-  // Tile size
-  map_info.tile_size.x =
-      static_cast<int>(json["tilesets"][0]["tilewidth"].number().value_or(0));
-  map_info.tile_size.y =
-      static_cast<int>(json["tilesets"][0]["tileheight"].number().value_or(0));
-  if (map_info.tile_size.x == 0 or map_info.tile_size.y == 0)
-    return std::nullopt;
+    reader.members([&](std::string_view key) {
+      if (key == "name") {
+        layer.name = reader.string().value_or("");
+        named      = true;
+      } else if (key == "tileset") {
+        tileset = reader.string();
+      } else if (key == "data") {
+        const auto tiles_per = size_in_tiles();
+        if (tiles_per and is_selected()) {
+          decode(reader, layer, *tiles_per);
+        } else {
+          layer.data = reader.skip();
+        }
+      } else {
+        reader.skip();
+      }
+    });
 
-  // Canvas size
-  map_info.canvas_size.x =
-      static_cast<int>(json["canvas"]["width"].number().value_or(0));
-  map_info.canvas_size.y =
-      static_cast<int>(json["canvas"]["height"].number().value_or(0));
-  if (map_info.canvas_size.x == 0 or map_info.canvas_size.y == 0)
-    return std::nullopt;
+    named = true;
+    if (!is_selected()) return;
+    if (!texture) texture = std::move(tileset);
+    pending.push_back(std::move(layer));
+  };
 
-  // Tileset filename
-  const auto maybe_filename = json["layers"][0]["tileset"].string();
-  if (!maybe_filename) return std::nullopt;
-  map_info.texture_filename = *maybe_filename;
+  reader.members([&](std::string_view key) {
+    if (key == "canvas") {
+      reader.members([&](std::string_view key) {
+        if (key == "width") {
+          map_info.canvas_size.x = integer();
+        } else if (key == "height") {
+          map_info.canvas_size.y = integer();
+        } else {
+          reader.skip();
+        }
+      });
+    } else if (key == "tilesets") {
+      reader.elements([&](size_t index) {
+        if (index != 0) {
+          reader.skip();
+          return;
+        }
+        reader.members([&](std::string_view key) {
+          if (key == "tilewidth") {
+            map_info.tile_size.x = integer();
+          } else if (key == "tileheight") {
+            map_info.tile_size.y = integer();
+          } else {
+            reader.skip();
+          }
+        });
+      });
+    } else if (key == "layers") {
+      reader.elements(read_layer);
+    } else {
+      reader.skip();
+    }
+  });
+  if (!reader.done()) return std::nullopt;
 
-  return map_info;
+  // A map without rows or columns cannot hold any tiles.
+  const auto tiles_per = size_in_tiles();
+  if (!tiles_per or !texture or pending.empty()) return std::nullopt;
+  map_info.texture_filename = std::move(*texture);
+
+  auto layers = std::vector<DecodedLayer<CELL>>{};
+  layers.reserve(pending.size());
+  for (auto& layer : pending) {
+    if (!layer.grid) {
+      auto data_reader = Utils::JsonReader{layer.data.value_or("[]")};
+      decode(data_reader, layer, *tiles_per);
+    }
+
+    // Ensure the correct number of values was present in the .data
+    if (layer.values != layer.grid->width() * layer.grid->height())
+      return std::nullopt;
+    layers.push_back({.position = layer.position,
+                      .name     = std::move(layer.name),
+                      .grid     = std::move(*layer.grid)});
+  }
+  return std::make_pair(std::move(map_info), std::move(layers));
+}
+
+//
+// stack() implements flatten(), stacking the layers |above| onto the |grid|.
+// Cells for which |is_empty| returns true do not replace the cells below.
+//
+template <typename CELL>
+[[nodiscard]] auto stack(Utils::Grid<CELL> grid, const auto& above,
+                         auto&& is_empty) -> Utils::Grid<CELL> {
+  for (const auto& layer : above) {
+    for (const auto position : grid.coordinates())
+      if (!is_empty(layer.grid[position]))
+        grid[position] = layer.grid[position];
+  }
+  return grid;
+}
+
+// Returns true for tiles that are not set on a layer
+[[nodiscard]] auto isEmpty(Utils::Coordinate tile) -> bool {
+  return tile == Utils::Coordinate{};
+}
+
+// Returns the tile itself, for layers decoded into tileset coordinates
+[[nodiscard]] auto asTile(Utils::Coordinate tile) -> Utils::Coordinate {
+  return tile;
+}
+
+//
+// compactMapFromJson() implements compactFromJson(), invoking |on_tile| with
+// the position and coordinate of each tile as the layer data is decoded.
+//
+[[nodiscard]] auto compactMapFromJson(std::string_view json_text,
+                                      const LayerSelection& selected,
+                                      auto&& on_tile)
+    -> std::optional<std::pair<Info, CompactGrid>> {
+  auto palette = Palette{};
+  auto full    = false;
+
+  // Maps tend to have runs of identical tiles, so the previous tile is checked
+  // before looking up the palette
+  auto previous    = std::optional<std::pair<Utils::Coordinate, TileId>>{};
+  const auto to_id = [&](Utils::Coordinate tile) -> TileId {
+    if (!previous or previous->first != tile) {
+      const auto id = palette.intern(tile);
+      if (!id) {
+        full = true;
+        return {};
+      }
+      previous = std::pair{tile, *id};
+    }
+    return previous->second;
+  };
+
+  auto maybe_layers = mapFromJson<TileId>(json_text, selected, to_id, on_tile);
+  if (!maybe_layers or full) return std::nullopt;
+
+  auto& [info, decoded] = *maybe_layers;
+  const auto empty      = palette.find(Utils::Coordinate{});
+  auto ids              = stack(
+      std::move(decoded.front().grid), std::span{decoded}.subspan(1),
+      [&](TileId id) { return empty and id == *empty; });
+  return std::make_pair(std::move(info),
+                        CompactGrid{std::move(palette), std::move(ids)});
+}
+
+//
+// indexOf() returns the tile index of a compact |grid|, looking up the unit
+// and target tiles in the palette property table.
+//
+[[nodiscard]] auto indexOf(const CompactGrid& grid) -> TileIndex {
+  auto index = TileIndex{};
+  for (const auto pos : grid.ids().coordinates()) {
+    const auto& properties = grid.properties(pos);
+    if (properties.unit_color or properties.target_color)
+      index.add(grid.palette().tile(grid[pos]), pos);
+  }
+  return index;
 }
 
 }  // namespace tilemap::internal
 
 namespace tilemap {
 
+TileIndex::TileIndex(const Grid& grid) {
+  for (const auto position : grid.coordinates()) add(grid[position], position);
+}
+
+void TileIndex::add(Utils::Coordinate tile, Utils::Coordinate position) {
+  const auto indexed = [&](const auto& route) {
+    return tile == route.unit_tile or tile == route.target_tile;
+  };
+  if (std::ranges::any_of(woodland::UNIT_TARGETS, indexed))
+    positions_[tile].push_back(position);
+}
+
+auto TileIndex::find(Utils::Coordinate tile) const
+    -> std::optional<Utils::Coordinate> {
+  const auto positions = positions_.find(tile);
+  if (positions == positions_.end()) return std::nullopt;
+  return positions->second.front();
+}
+
+auto TileIndex::findAll(Utils::Coordinate tile) const
+    -> std::vector<Utils::Coordinate> {
+  const auto positions = positions_.find(tile);
+  if (positions == positions_.end()) return {};
+  return positions->second;
+}
+
+auto LayerSelection::all() -> LayerSelection {
+  auto selection = LayerSelection{};
+  selection.all_ = true;
+  return selection;
+}
+
+auto LayerSelection::parse(std::string_view spec)
+    -> std::optional<LayerSelection> {
+  if (spec.empty()) return std::nullopt;
+
+  auto selection = LayerSelection{};
+  selection.positions_.clear();
+  for (const auto entry : spec | std::views::split(',')) {
+    const auto text = std::string_view{entry.begin(), entry.end()};
+    if (text.empty()) return std::nullopt;
+
+    auto position           = size_t{};
+    const auto* last        = text.data() + text.size();
+    const auto [end, error] = std::from_chars(text.data(), last, position);
+    if (error == std::errc{} and end == last) {
+      selection.positions_.push_back(position);
+    } else {
+      selection.names_.emplace_back(text);
+    }
+  }
+  return selection;
+}
+
+auto LayerSelection::single() const -> bool {
+  return !all_ and names_.empty() and positions_.size() <= 1;
+}
+
+auto LayerSelection::byName() const -> bool {
+  return !all_ and !names_.empty();
+}
+
+auto LayerSelection::includes(size_t position) const -> bool {
+  return all_ or std::ranges::find(positions_, position) != positions_.end();
+}
+
+auto LayerSelection::includes(size_t position, std::string_view name) const
+    -> bool {
+  return includes(position) or
+         std::ranges::find(names_, name) != names_.end();
+}
+
+[[nodiscard]] auto layersFromJson(std::string_view json_text,
+                                  const LayerSelection& selected)
+    -> std::optional<std::pair<Info, Layers>> {
+  auto maybe_layers = internal::mapFromJson<Utils::Coordinate>(
+      json_text, selected, internal::asTile,
+      [](Utils::Coordinate, Utils::Coordinate) {});
+  if (!maybe_layers) return std::nullopt;
+
+  auto layers = Layers{};
+  for (auto& layer : maybe_layers->second) {
+    layers.push_back({.position = layer.position,
+                      .name     = std::move(layer.name),
+                      .grid     = std::move(layer.grid)});
+  }
+  return std::make_pair(std::move(maybe_layers->first), std::move(layers));
+}
+
+[[nodiscard]] auto flatten(const Layers& layers) -> Grid {
+  return internal::stack(layers.front().grid, std::span{layers}.subspan(1),
+                         internal::isEmpty);
+}
+
 //
 // fromJson() attempts to parse a RiskyLab compatible JSON file containing a
-// tilemap, and optionally returns a Utils::Grid<> containing the layers[0].data
-// values.
+// tilemap, and optionally returns a Utils::Grid<> containing the |selected|
+// layers, stacked into a single grid.
+//
+[[nodiscard]] auto fromJson(std::string_view json_text,
+                            const LayerSelection& selected)
+    -> std::optional<std::pair<Info, Grid>> {
+  auto maybe_layers = layersFromJson(json_text, selected);
+  if (!maybe_layers) return std::nullopt;
+
+  auto& [info, layers] = *maybe_layers;
+  auto grid            = internal::stack(std::move(layers.front().grid),
+                                         std::span{layers}.subspan(1),
+                                         internal::isEmpty);
+  return std::make_pair(std::move(info), std::move(grid));
+}
+
 //
-// NOTE(AE) - This function is currently hard-coded to consider layer 0 only.
+// fromJson() variant that additionally builds the tile |index| of the map.
 //
-[[nodiscard]] auto fromJson(std::string_view json_text)
+// The index is built while decoding a single selected layer. Stacked layers
+// may replace tiles of lower layers, so the index of multiple layers is built
+// from the stacked grid instead.
+//
+[[nodiscard]] auto fromJson(std::string_view json_text, TileIndex& index,
+                            const LayerSelection& selected)
     -> std::optional<std::pair<Info, Grid>> {
-  const auto maybe_json = json::Json::parse(json_text);
-  if (!maybe_json) return std::nullopt;
+  if (!selected.single()) {
+    auto maybe_map = fromJson(json_text, selected);
+    if (maybe_map) index = TileIndex{maybe_map->second};
+    return maybe_map;
+  }
+
+  auto tiles        = TileIndex{};
+  auto maybe_layers = internal::mapFromJson<Utils::Coordinate>(
+      json_text, selected, internal::asTile,
+      [&](Utils::Coordinate position, Utils::Coordinate tile) {
+        tiles.add(tile, position);
+      });
+  if (!maybe_layers) return std::nullopt;
 
-  const auto maybe_map_info = internal::mapInfoFromJson(*maybe_json);
-  if (!maybe_map_info) return std::nullopt;
+  index = std::move(tiles);
+  return std::make_pair(std::move(maybe_layers->first),
+                        std::move(maybe_layers->second.front().grid));
+}
+
+[[nodiscard]] auto compactFromJson(std::string_view json_text,
+                                   const LayerSelection& selected)
+    -> std::optional<std::pair<Info, CompactGrid>> {
+  return internal::compactMapFromJson(
+      json_text, selected, [](Utils::Coordinate, Utils::Coordinate) {});
+}
 
-  const auto& map_info = *maybe_map_info;
-  const auto tiles =
-      internal::coordinatesFromJsonData((*maybe_json)["layers"][0]["data"]);
+//
+// compactFromJson() variant that additionally builds the tile |index| of the
+// map, as the corresponding fromJson() variant does.
+//
+[[nodiscard]] auto compactFromJson(std::string_view json_text,
+                                   TileIndex& index,
+                                   const LayerSelection& selected)
+    -> std::optional<std::pair<Info, CompactGrid>> {
+  if (!selected.single()) {
+    auto maybe_map = compactFromJson(json_text, selected);
+    if (maybe_map) index = internal::indexOf(maybe_map->second);
+    return maybe_map;
+  }
 
-  // Ensure the correct number of values was present in the .data
-  const auto tiles_per = map_info.canvas_size / map_info.tile_size;
-  const auto tile_count =
-      static_cast<size_t>(tiles_per.x) * static_cast<size_t>(tiles_per.y);
-  if (tiles.size() != tile_count) return std::nullopt;
+  auto tiles     = TileIndex{};
+  auto maybe_map = internal::compactMapFromJson(
+      json_text, selected,
+      [&](Utils::Coordinate position, Utils::Coordinate tile) {
+        tiles.add(tile, position);
+      });
+  if (!maybe_map) return std::nullopt;
 
-  // Finally, convert to a Utils::Grid
-  return std::make_pair(map_info,
-                        Grid{static_cast<size_t>(tiles_per.x), tiles});
+  index = std::move(tiles);
+  return maybe_map;
 }
 
 }  // namespace tilemap
@@ -1,10 +1,13 @@
 #ifndef TILEMAP_HH
 #define TILEMAP_HH
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "utils/coordinate.hh"
 #include "utils/grid.hh"
@@ -33,14 +36,128 @@ struct RouteMapping {
   Utils::Coordinate target_tile;
 };
 
+//
+// TileIndex holds the positions of the unit and target tiles on a map (see
+// woodland::UNIT_TARGETS), grouped by tile. All other tiles are ignored.
+//
+// It provides the same find() and findAll() interface as Grid, but answers in
+// O(matches) rather than scanning the entire map. Positions are kept in the
+// same (row by row) order as the Grid algorithms return them.
+//
+class TileIndex {
+  std::unordered_map<Utils::Coordinate, std::vector<Utils::Coordinate>>
+      positions_{};
+
+ public:
+  [[nodiscard]] TileIndex() = default;
+
+  // Indexes the unit and target tiles of an existing |grid|
+  [[nodiscard]] explicit TileIndex(const Grid& grid);
+
+  // Positions of a given tile must be added row by row.
+  void add(Utils::Coordinate tile, Utils::Coordinate position);
+
+  [[nodiscard]] auto find(Utils::Coordinate tile) const
+      -> std::optional<Utils::Coordinate>;
+
+  [[nodiscard]] auto findAll(Utils::Coordinate tile) const
+      -> std::vector<Utils::Coordinate>;
+};
+
+//
+// TerrainCost assigns the cost of entering a tile (see Utils::CostGrid)
+//
+struct TerrainCost {
+  Utils::Coordinate tile;
+  uint8_t cost;
+};
+
+//
+// LayerSelection selects the layers of a map that are decoded (see fromJson()),
+// by their position in the "layers" array or by their "name". The data of all
+// other layers is skipped without being decoded.
+//
+// By default, only the first layer (layers[0]) is selected.
+//
+class LayerSelection {
+  std::vector<size_t> positions_{0};
+  std::vector<std::string> names_{};
+  bool all_{};
+
+ public:
+  [[nodiscard]] LayerSelection() = default;
+
+  // Selects every layer of a map
+  [[nodiscard]] static auto all() -> LayerSelection;
+
+  //
+  // parse() reads a comma separated list of layer positions and names (ex.
+  // "1,units"). Returns std::nullopt if the list (or any entry) is empty.
+  //
+  [[nodiscard]] static auto parse(std::string_view spec)
+      -> std::optional<LayerSelection>;
+
+  // Returns true if no more than a single layer can be selected, by position
+  [[nodiscard]] auto single() const -> bool;
+
+  // Returns true if layers may be selected by name
+  [[nodiscard]] auto byName() const -> bool;
+
+  // Returns true if the layer at |position| is selected, regardless of name
+  [[nodiscard]] auto includes(size_t position) const -> bool;
+
+  [[nodiscard]] auto includes(size_t position, std::string_view name) const
+      -> bool;
+};
+
+//
+// Layer holds a single decoded map layer
+//
+struct Layer {
+  size_t position;
+  std::string name;
+  Grid grid;
+};
+
+using Layers = std::vector<Layer>;
+
+//
+// layersFromJson() attempts to parse a RiskyLab compatible JSON file containing
+// a tilemap, and optionally returns the |selected| layers, in the order they
+// appear in the file. Fails if no layer is selected, or any selected layer does
+// not match the canvas size.
+//
+// The Info texture is taken from the first selected layer naming a tileset.
+//
+[[nodiscard]] auto layersFromJson(std::string_view json_text,
+                                  const LayerSelection& selected)
+    -> std::optional<std::pair<Info, Layers>>;
+
+//
+// flatten() stacks the |layers| into a single grid, where each tile is taken
+// from the last layer that is not empty at that position.
+//
+// Expects at least one layer (see layersFromJson()).
+//
+[[nodiscard]] auto flatten(const Layers& layers) -> Grid;
+
 //
 // fromJson() attempts to parse a RiskyLab compatible JSON file containing a
-// tilemap, and optionally returns a Utils::Grid<> containing the layers[0].data
-// values.
+// tilemap, and optionally returns a Utils::Grid<> containing the |selected|
+// layers, stacked as by flatten(). By default, this is layers[0].data only.
+//
+[[nodiscard]] auto fromJson(std::string_view json_text,
+                            const LayerSelection& selected = {})
+    -> std::optional<std::pair<Info, Grid>>;
+
 //
-// Note that this is currently hard-coded to consider layer 0 only.
+// fromJson() variant that additionally builds the tile |index| of the map,
+// in the same pass that decodes the layer data (unless multiple layers may be
+// selected, see LayerSelection::single()). The |index| is left unchanged if the
+// map cannot be parsed.
 //
-[[nodiscard]] auto fromJson(std::string_view json_text)
+[[nodiscard]] auto fromJson(std::string_view json_text, TileIndex& index,
+                            const LayerSelection& selected = {})
     -> std::optional<std::pair<Info, Grid>>;
 
 }  // namespace tilemap
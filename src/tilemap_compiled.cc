@@ -0,0 +1,261 @@
+#include "src/tilemap_compiled.hh"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "src/tilemap.hh"
+#include "src/tilemap_palette.hh"
+#include "src/tilemap_woodland.hh"
+#include "utils/bit_grid.hh"
+#include "utils/coordinate.hh"
+#include "utils/grid.hh"
+
+namespace {
+
+constexpr auto MAGIC   = std::array{'P', 'F', 'M', 'P'};
+constexpr auto VERSION = uint32_t{4};
+
+//
+// Header at the start of a compiled map file. The sections listed in Layout
+// follow, each starting at a multiple of 8 bytes.
+//
+struct Header {
+  std::array<char, 4> magic;
+  uint32_t version;
+  uint32_t width;
+  uint32_t height;
+  int32_t canvas_width;
+  int32_t canvas_height;
+  int32_t tile_width;
+  int32_t tile_height;
+  uint32_t texture_size;
+  uint32_t palette_size;
+  uint32_t index_size;
+  uint32_t reserved;
+};
+
+// Tileset coordinate of a palette entry
+struct PaletteEntry {
+  int32_t x;
+  int32_t y;
+};
+
+// Position of a unit or target |tile| on the map
+struct IndexEntry {
+  PaletteEntry tile;
+  int32_t x;
+  int32_t y;
+};
+
+static_assert(sizeof(Header) % sizeof(uint64_t) == 0);
+
+[[nodiscard]] constexpr auto padded(size_t size) -> size_t {
+  return (size + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+}
+
+//
+// Layout holds the offsets of the sections of a compiled map file:
+//
+//   texture   - Texture filename (texture_size characters)
+//   palette   - PaletteEntry for every TileId (palette_size entries)
+//   ids       - TileId of every tile, row by row (width * height ids)
+//   passable  - Passability words (see Utils::BitGrid::words())
+//   index     - IndexEntry for every unit and target tile (index_size entries)
+//
+struct Layout {
+  size_t texture;
+  size_t palette;
+  size_t ids;
+  size_t passable;
+  size_t index;
+  size_t size;
+};
+
+// Returns the number of passability words per row of the map
+[[nodiscard]] constexpr auto wordsPerRow(const Header& header) -> size_t {
+  return (size_t{header.width} + Utils::BitGrid::BITS_PER_WORD - 1) /
+         Utils::BitGrid::BITS_PER_WORD;
+}
+
+[[nodiscard]] constexpr auto layoutOf(const Header& header) -> Layout {
+  const auto tiles = size_t{header.width} * header.height;
+
+  const auto words = wordsPerRow(header) * header.height;
+
+  auto layout     = Layout{};
+  layout.texture  = sizeof(Header);
+  layout.palette  = layout.texture + padded(header.texture_size);
+  layout.ids      = layout.palette +
+                    (header.palette_size * sizeof(PaletteEntry));
+  layout.passable = layout.ids + padded(tiles * sizeof(tilemap::TileId));
+  layout.index    = layout.passable + (words * sizeof(uint64_t));
+  layout.size     = layout.index + (header.index_size * sizeof(IndexEntry));
+  return layout;
+}
+
+// Returns the |count| values of type T stored at |offset| within |bytes|
+template <typename T>
+[[nodiscard]] auto section(std::string_view bytes, size_t offset, size_t count)
+    -> std::span<const T> {
+  // Mappings are page aligned, and every section starts at a multiple of the
+  // value alignment, so the values can be accessed in place.
+  return {reinterpret_cast<const T*>(bytes.data() + offset), count};
+}
+
+// Appends the raw bytes of |values| to |bytes|, padded to a multiple of 8
+template <typename T>
+void append(std::string& bytes, std::span<const T> values) {
+  bytes.append(reinterpret_cast<const char*>(values.data()),
+               values.size_bytes());
+  bytes.resize(padded(bytes.size()));
+}
+
+}  // namespace
+
+namespace tilemap {
+
+[[nodiscard]] auto isCompiledMap(std::string_view bytes) -> bool {
+  return bytes.starts_with(std::string_view{MAGIC.data(), MAGIC.size()});
+}
+
+[[nodiscard]] auto fromCompiledMap(std::string_view bytes)
+    -> std::optional<CompiledMap> {
+  if (!isCompiledMap(bytes) or bytes.size() < sizeof(Header))
+    return std::nullopt;
+
+  auto header = Header{};
+  std::memcpy(&header, bytes.data(), sizeof(Header));
+  if (header.version != VERSION or header.width == 0 or header.height == 0 or
+      header.palette_size == 0 or header.palette_size > Palette::MAX_TILES)
+    return std::nullopt;
+
+  // The dimensions are limited by the file size before any section offset is
+  // computed, so the offsets cannot overflow.
+  const auto tiles = size_t{header.width} * header.height;
+  if (tiles > bytes.size()) return std::nullopt;
+
+  const auto layout = layoutOf(header);
+  if (layout.size != bytes.size()) return std::nullopt;
+
+  auto info = Info{
+      .canvas_size = {.x = header.canvas_width, .y = header.canvas_height},
+      .tile_size   = {.x = header.tile_width, .y = header.tile_height},
+      .texture_filename =
+          std::string{bytes.substr(layout.texture, header.texture_size)}};
+
+  auto palette = Palette{};
+  for (const auto entry : section<PaletteEntry>(bytes, layout.palette,
+                                                header.palette_size))
+    if (!palette.intern({.x = entry.x, .y = entry.y})) return std::nullopt;
+  if (palette.size() != header.palette_size) return std::nullopt;
+
+  // Tile ids beyond the palette would resolve to no tile.
+  const auto ids = section<TileId>(bytes, layout.ids, tiles);
+  if (std::ranges::any_of(ids, [&](auto id) { return id >= palette.size(); }))
+    return std::nullopt;
+
+  auto grid =
+      CompactGrid{std::move(palette), Utils::Grid<TileId>{header.width, ids}};
+
+  // Searches on the bitmap (see Utils::BitBfs) rely on the bits past the last
+  // column of every row being zero.
+  const auto words_per_row = wordsPerRow(header);
+  const auto words         = section<uint64_t>(bytes, layout.passable,
+                                               words_per_row * header.height);
+  const auto columns = header.width % Utils::BitGrid::BITS_PER_WORD;
+  if (columns != 0) {
+    const auto padding = ~uint64_t{} << columns;
+    for (auto y = size_t{}; y < header.height; ++y)
+      if ((words[((y + 1) * words_per_row) - 1] & padding) != 0)
+        return std::nullopt;
+  }
+  auto passable = Utils::BitGrid{header.width, header.height, words};
+
+  // Every index entry must name the unit or target tile at its position, and
+  // the positions of a tile must be listed row by row (see TileIndex::add())
+  auto index = TileIndex{};
+  auto next  = std::vector<size_t>(grid.palette().size());
+  for (const auto entry :
+       section<IndexEntry>(bytes, layout.index, header.index_size)) {
+    const auto tile = Utils::Coordinate{.x = entry.tile.x, .y = entry.tile.y};
+    const auto position = Utils::Coordinate{.x = entry.x, .y = entry.y};
+    if (!grid.inBounds(position) or grid.palette().tile(grid[position]) != tile)
+      return std::nullopt;
+
+    const auto& properties = grid.properties(position);
+    if (!properties.unit_color and !properties.target_color)
+      return std::nullopt;
+
+    const auto offset = (static_cast<size_t>(position.y) * header.width) +
+                        static_cast<size_t>(position.x);
+    if (offset < next[grid[position]]) return std::nullopt;
+    next[grid[position]] = offset + 1;
+    index.add(tile, position);
+  }
+
+  return CompiledMap{.info     = std::move(info),
+                     .grid     = std::move(grid),
+                     .passable = std::move(passable),
+                     .index    = std::move(index)};
+}
+
+[[nodiscard]] auto toCompiledMap(const Info& info, const CompactGrid& grid,
+                                 const TileIndex& tiles) -> std::string {
+  auto palette = std::vector<PaletteEntry>{};
+  for (auto id = size_t{}; id < grid.palette().size(); ++id) {
+    const auto tile = grid.palette().tile(static_cast<TileId>(id));
+    palette.push_back({.x = tile.x, .y = tile.y});
+  }
+
+  auto ids = std::vector<TileId>{};
+  ids.reserve(grid.width() * grid.height());
+  for (const auto pos : grid.ids().coordinates()) ids.push_back(grid[pos]);
+
+  const auto passable = Utils::BitGrid::from(
+      grid.width(), grid.height(),
+      [&](auto pos) { return grid.passable(pos); });
+
+  // Units and targets, in the order TileIndex returns them
+  auto index = std::vector<IndexEntry>{};
+  for (const auto& route : woodland::UNIT_TARGETS) {
+    for (const auto tile : {route.unit_tile, route.target_tile}) {
+      for (const auto pos : tiles.findAll(tile))
+        index.push_back(
+            {.tile = {.x = tile.x, .y = tile.y}, .x = pos.x, .y = pos.y});
+    }
+  }
+
+  const auto header = Header{
+      .magic         = MAGIC,
+      .version       = VERSION,
+      .width         = static_cast<uint32_t>(grid.width()),
+      .height        = static_cast<uint32_t>(grid.height()),
+      .canvas_width  = info.canvas_size.x,
+      .canvas_height = info.canvas_size.y,
+      .tile_width    = info.tile_size.x,
+      .tile_height   = info.tile_size.y,
+      .texture_size  = static_cast<uint32_t>(info.texture_filename.size()),
+      .palette_size  = static_cast<uint32_t>(palette.size()),
+      .index_size    = static_cast<uint32_t>(index.size()),
+      .reserved      = 0};
+
+  auto bytes = std::string{};
+  bytes.reserve(layoutOf(header).size);
+  append(bytes, std::span{&header, 1});
+  append(bytes, std::span{info.texture_filename});
+  append(bytes, std::span<const PaletteEntry>{palette});
+  append(bytes, std::span<const TileId>{ids});
+  append(bytes, passable.words());
+  append(bytes, std::span<const IndexEntry>{index});
+  return bytes;
+}
+
+}  // namespace tilemap
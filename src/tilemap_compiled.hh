@@ -0,0 +1,63 @@
+#ifndef TILEMAP_COMPILED_HH
+#define TILEMAP_COMPILED_HH
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "src/tilemap.hh"
+#include "src/tilemap_palette.hh"
+#include "utils/bit_grid.hh"
+
+namespace tilemap {
+
+//
+// CompiledMap holds a tilemap loaded from a compiled (.pfmap) map file, which
+// is produced from a RiskyLab JSON map by the compile_map utility.
+//
+// Besides the map Info and the compact grid (see CompactGrid), the file holds
+// everything path finding needs up front; the passability bitmap of the map
+// (see path_finder::passabilityOf()) and the positions of all unit and target
+// tiles (see TileIndex).
+//
+struct CompiledMap {
+  Info info;
+  CompactGrid grid;
+  Utils::BitGrid passable;
+  TileIndex index;
+};
+
+//
+// isCompiledMap() returns true if the |bytes| of a map file hold a compiled
+// map (rather than JSON), based on the file signature.
+//
+[[nodiscard]] auto isCompiledMap(std::string_view bytes) -> bool;
+
+//
+// fromCompiledMap() returns the map held by the |bytes| of a compiled map
+// file, or std::nullopt if the file is not a valid compiled map of the current
+// version. Tile ids and index entries are validated against the palette and
+// the map dimensions, and the padding bits of the passability bitmap must be
+// zero.
+//
+// All sections of the file are taken over as stored (ex. the tile ids and
+// passability words are copied as single blocks), so no tile is decoded
+// individually. The |bytes|
+// are expected to be memory mapped (see Utils::FileContent).
+//
+[[nodiscard]] auto fromCompiledMap(std::string_view bytes)
+    -> std::optional<CompiledMap>;
+
+//
+// toCompiledMap() returns the compiled map file content for a given map and
+// its tile |index| (see compactFromJson()).
+//
+// Values are stored in native byte order; compiled maps are not meant to be
+// shared between machines.
+//
+[[nodiscard]] auto toCompiledMap(const Info& info, const CompactGrid& grid,
+                                 const TileIndex& index) -> std::string;
+
+}  // namespace tilemap
+
+#endif  // TILEMAP_COMPILED_HH
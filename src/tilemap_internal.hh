@@ -1,19 +1,32 @@
 #ifndef TILEMAP_INTERNAL_HH
 #define TILEMAP_INTERNAL_HH
 
-#include <fmt/core.h>
+#include <array>
+#include <charconv>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 
-#include <vector>
-
-#include "json/json.hh"
 #include "utils/coordinate.hh"
 
 namespace tilemap::internal {
 
 //
-// coordinateFrom<>() returns a Utils::Coordinate<> by parsing the integer
-// digits of the floating point number as the X coordinate, while the factional
-// part is parsed to be the Y coordinate.
+// coordinateFrom() returns a Utils::Coordinate<> from the |text| of a JSON
+// number, by parsing the integer digits as the X coordinate, while the digits
+// of the fractional part are parsed to be the Y coordinate.
+//
+// The digits are taken from the text as written, without any allocation, so
+// fractional components with trailing zeros (ex. "2.10") are parsed correctly.
+// Numbers written with an exponent are parsed as a floating point number (see
+// below). Zero, negative numbers and malformed text yield Coordinate{}.
+//
+[[nodiscard]] inline auto coordinateFrom(std::string_view text)
+    -> Utils::Coordinate;
+
+//
+// coordinateFrom<>() variant that parses a floating point number, by way of
+// its shortest (fixed point) text representation.
 //
 // WARNING(AE) - Since coordinates are parsed from a floating point number,
 // fractional components with trailing zeros are not correctly passed. This is a
@@ -21,34 +34,48 @@ namespace tilemap::internal {
 //
 template <typename NUMBER>
   requires std::is_floating_point_v<NUMBER>
-[[nodiscard]] constexpr auto coordinateFrom(NUMBER number)
-    -> Utils::Coordinate {
+[[nodiscard]] auto coordinateFrom(NUMBER number) -> Utils::Coordinate {
   if (number <= 0) return {};
   // NOTE(AE) - An itermediate string representation is used here to avoid
   // floating point erros when attempting to use interger math/modulus
   // operations on the fractional value.
-  const auto xy_string = fmt::format("{}", number);
-  const auto period_at = xy_string.find('.');
-  const auto x         = std::atoi(xy_string.substr(0, period_at).data());
-  const auto y         = period_at == std::string::npos
-                             ? 0
-                             : std::atoi(xy_string.substr(period_at + 1).data());
-  return {.x = x, .y = y};
+  auto text               = std::array<char, 64>{};
+  const auto [end, error] = std::to_chars(
+      text.data(), text.data() + text.size(), number, std::chars_format::fixed);
+  if (error != std::errc{}) return {};
+  return coordinateFrom(std::string_view{text.data(), end});
 }
 
-//
-// coordinatesFromJsonData() return a vector of coordinates from a given json
-// array of numbers.
-//
-template <typename T>
-[[nodiscard]] constexpr auto coordinatesFromJsonData(
-    const json::ValueIterator<T>& data) -> std::vector<Utils::Coordinate> {
-  auto coordinates = std::vector<Utils::Coordinate>{};
-  for (const auto& value : data) {
-    const auto float_value = value.number().value_or(.0);
-    coordinates.emplace_back(coordinateFrom(float_value));
+[[nodiscard]] inline auto coordinateFrom(std::string_view text)
+    -> Utils::Coordinate {
+  if (text.find_first_of("eE") != std::string_view::npos) {
+    auto number = double{};
+    std::from_chars(text.data(), text.data() + text.size(), number);
+    return coordinateFrom(number);
   }
-  return coordinates;
+
+  const auto period_at = text.find('.');
+  const auto integer   = text.substr(0, period_at);
+  const auto fraction  = period_at == std::string_view::npos
+                             ? std::string_view{}
+                             : text.substr(period_at + 1);
+
+  // Accumulates the decimal |digits|; false if any character is not a digit
+  // Nine digits always fit an int.
+  const auto parse = [](std::string_view digits, int& value) {
+    if (digits.size() > 9) return false;
+    for (const auto digit : digits) {
+      if (digit < '0' or digit > '9') return false;
+      value = (value * 10) + (digit - '0');
+    }
+    return true;
+  };
+
+  auto coordinate = Utils::Coordinate{};
+  if (integer.empty() or !parse(integer, coordinate.x) or
+      !parse(fraction, coordinate.y))
+    return {};
+  return coordinate;
 }
 
 }  // namespace tilemap::internal
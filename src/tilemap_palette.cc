@@ -0,0 +1,84 @@
+#include "src/tilemap_palette.hh"
+
+#include <optional>
+#include <utility>
+
+#include "src/tilemap.hh"
+#include "src/tilemap_woodland.hh"
+#include "utils/coordinate.hh"
+#include "utils/cost_grid.hh"
+#include "utils/grid.hh"
+
+namespace {
+
+//
+// propertiesOf() returns the properties of a |tile| of the woodland tileset.
+//
+[[nodiscard]] auto propertiesOf(Utils::Coordinate tile)
+    -> tilemap::TileProperties {
+  auto properties     = tilemap::TileProperties{};
+  properties.cost     = tilemap::woodland::terrainCost(tile);
+  properties.passable = properties.cost != Utils::CostGrid::IMPASSABLE;
+
+  const auto& routes = tilemap::woodland::UNIT_TARGETS;
+  for (auto color = size_t{}; color < routes.size(); ++color) {
+    if (tile == routes[color].unit_tile) properties.unit_color = color;
+    if (tile == routes[color].target_tile) properties.target_color = color;
+  }
+  return properties;
+}
+
+}  // namespace
+
+namespace tilemap {
+
+[[nodiscard]] auto Palette::intern(Utils::Coordinate tile)
+    -> std::optional<TileId> {
+  if (const auto it = ids_.find(tile); it != ids_.end()) return it->second;
+  if (tiles_.size() == MAX_TILES) return std::nullopt;
+
+  const auto id = static_cast<TileId>(tiles_.size());
+  tiles_.push_back(tile);
+  properties_.push_back(propertiesOf(tile));
+  ids_.emplace(tile, id);
+  return id;
+}
+
+[[nodiscard]] auto Palette::find(Utils::Coordinate tile) const
+    -> std::optional<TileId> {
+  if (const auto it = ids_.find(tile); it != ids_.end()) return it->second;
+  return std::nullopt;
+}
+
+CompactGrid::CompactGrid(Palette palette, Utils::Grid<TileId> ids)
+    : palette_{std::move(palette)}, ids_{std::move(ids)} {}
+
+[[nodiscard]] auto CompactGrid::expand() const -> Grid {
+  auto grid = Grid{width(), height()};
+  for (const auto pos : ids_.coordinates())
+    grid[pos] = palette_.tile(ids_[pos]);
+  return grid;
+}
+
+//
+// compact() returns the CompactGrid representation of a given |grid|.
+//
+[[nodiscard]] auto compact(const Grid& grid) -> std::optional<CompactGrid> {
+  auto palette = Palette{};
+  auto ids     = Utils::Grid<TileId>{grid.width(), grid.height()};
+
+  // Maps tend to have runs of identical tiles, so the previous tile is checked
+  // before looking up the palette.
+  auto previous = std::optional<std::pair<Utils::Coordinate, TileId>>{};
+  for (const auto pos : grid.coordinates()) {
+    if (!previous or previous->first != grid[pos]) {
+      const auto id = palette.intern(grid[pos]);
+      if (!id) return std::nullopt;
+      previous = std::pair{grid[pos], *id};
+    }
+    ids[pos] = previous->second;
+  }
+  return CompactGrid{std::move(palette), std::move(ids)};
+}
+
+}  // namespace tilemap
@@ -0,0 +1,147 @@
+#ifndef TILEMAP_PALETTE_HH
+#define TILEMAP_PALETTE_HH
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "src/tilemap.hh"
+#include "src/tilemap_woodland.hh"
+#include "utils/coordinate.hh"
+#include "utils/grid.hh"
+
+namespace tilemap {
+
+//
+// TileId identifies a distinct tile within a Palette. Two bytes hold the tiles
+// of any realistic tileset; maps with more distinct tiles than that can only be
+// held as a full Grid.
+//
+using TileId = uint16_t;
+
+//
+// TileProperties holds the path finding relevant properties of a tile, as
+// defined by the woodland tileset (see tilemap_woodland.hh). Colors are
+// indices into woodland::UNIT_TARGETS, the cost is the terrain cost of the
+// tile (see woodland::TERRAIN_COSTS).
+//
+struct TileProperties {
+  bool passable{true};
+  uint8_t cost{woodland::DEFAULT_TERRAIN_COST};
+  std::optional<size_t> unit_color{};
+  std::optional<size_t> target_color{};
+};
+
+//
+// Palette interns the distinct tileset coordinates of a map into compact
+// TileIds, and holds a precomputed property table entry for each of them.
+//
+class Palette {
+  std::vector<Utils::Coordinate> tiles_{};
+  std::vector<TileProperties> properties_{};
+  std::unordered_map<Utils::Coordinate, TileId> ids_{};
+
+ public:
+  static constexpr auto MAX_TILES =
+      size_t{std::numeric_limits<TileId>::max()} + 1;
+
+  //
+  // intern() returns the TileId of a given |tile|, adding it to the palette if
+  // necessary. Returns std::nullopt if the palette is full.
+  //
+  [[nodiscard]] auto intern(Utils::Coordinate tile) -> std::optional<TileId>;
+
+  // Returns the TileId of a given |tile|, if it is part of the palette
+  [[nodiscard]] auto find(Utils::Coordinate tile) const
+      -> std::optional<TileId>;
+
+  [[nodiscard]] auto tile(TileId id) const -> Utils::Coordinate {
+    return tiles_[id];
+  }
+
+  [[nodiscard]] auto properties(TileId id) const -> const TileProperties& {
+    return properties_[id];
+  }
+
+  [[nodiscard]] auto size() const { return tiles_.size(); }
+};
+
+//
+// CompactGrid stores a tilemap as one TileId per tile, along with the Palette
+// to resolve the ids. This requires a quarter of the memory of a Grid, which
+// stores a full tileset coordinate per tile.
+//
+class CompactGrid {
+  Palette palette_;
+  Utils::Grid<TileId> ids_;
+
+ public:
+  [[nodiscard]] CompactGrid(Palette palette, Utils::Grid<TileId> ids);
+
+  [[nodiscard]] auto width() const { return ids_.width(); }
+
+  [[nodiscard]] auto height() const { return ids_.height(); }
+
+  [[nodiscard]] auto inBounds(Utils::Coordinate pos) const -> bool {
+    return ids_.inBounds(pos);
+  }
+
+  // Unchecked access; |pos| must be within the grid.
+  [[nodiscard]] auto operator[](Utils::Coordinate pos) const -> TileId {
+    return ids_[pos];
+  }
+
+  [[nodiscard]] auto properties(Utils::Coordinate pos) const
+      -> const TileProperties& {
+    return palette_.properties(ids_[pos]);
+  }
+
+  // Returns false for positions outside the grid
+  [[nodiscard]] auto passable(Utils::Coordinate pos) const -> bool {
+    return ids_.inBounds(pos) and properties(pos).passable;
+  }
+
+  [[nodiscard]] auto palette() const -> const Palette& { return palette_; }
+
+  [[nodiscard]] auto ids() const -> const Utils::Grid<TileId>& { return ids_; }
+
+  //
+  // expand() returns the full Grid representation of the map.
+  //
+  [[nodiscard]] auto expand() const -> Grid;
+};
+
+//
+// compact() returns the CompactGrid representation of a given |grid|, or
+// std::nullopt if the grid has more distinct tiles than a Palette can hold.
+//
+[[nodiscard]] auto compact(const Grid& grid) -> std::optional<CompactGrid>;
+
+//
+// compactFromJson() variant of fromJson() that returns the CompactGrid
+// representation of the map. Tiles are interned into the palette as the layer
+// data is decoded, so no Grid is held at any point.
+//
+// Returns std::nullopt if the map cannot be parsed, or has more distinct tiles
+// than a Palette can hold.
+//
+[[nodiscard]] auto compactFromJson(std::string_view json_text,
+                                   const LayerSelection& selected = {})
+    -> std::optional<std::pair<Info, CompactGrid>>;
+
+//
+// compactFromJson() variant that additionally builds the tile |index| of the
+// map (see fromJson()).
+//
+[[nodiscard]] auto compactFromJson(std::string_view json_text,
+                                   TileIndex& index,
+                                   const LayerSelection& selected = {})
+    -> std::optional<std::pair<Info, CompactGrid>>;
+
+}  // namespace tilemap
+
+#endif  // TILEMAP_PALETTE_HH
@@ -1,6 +1,14 @@
-#include "json/json.hh"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "src/tilemap.hh"
+#include "src/tilemap_compiled.hh"
 #include "src/tilemap_internal.hh"
+#include "src/tilemap_palette.hh"
+#include "src/tilemap_woodland.hh"
 #include "testrunner/testrunner.h"
 #include "utils/coordinate.hh"
 
@@ -17,6 +25,36 @@ constexpr auto FIVE_BY_FIVE_TEST_MAP =
 -1,3,-1,-1,-1,-1,3,0.6]}],"tilesets":[{"tilewidth":32,"tileheight":32}],
 "canvas":{"width":160,"height":160}})";
 
+// Same map as THREE_BY_ONE_TEST_MAP, with the map size preceding the layers
+constexpr auto SIZE_FIRST_TEST_MAP =
+    R"({"canvas":{"width":96,"height":32},"name":"size first",
+"tilesets":[{"tilewidth":32,"tileheight":32,"image":"woodland.png"}],
+"layers":[{"tileset":"MapEditor Tileset_woodland.png","visible":true,
+"data":[8.4,-1,0.6]}],"extra":[{"nested":[1,2,{"x":null}]}]})";
+
+// Ground, obstacle and unit layers; the obstacle layer is named after its data
+constexpr auto LAYERED_TEST_MAP =
+    R"({"layers":[{"name":"ground","tileset":"MapEditor Tileset_woodland.png",
+"data":[1,1,1]},{"data":[-1,3,-1],"name":"obstacles"},{"name":"units",
+"tileset":"woodland.png","data":[8.4,-1,0.6]}],
+"tilesets":[{"tilewidth":32,"tileheight":32}],
+"canvas":{"width":96,"height":32}})";
+
+// Returns the value of type T stored at |offset| within the |bytes|
+template <typename T>
+[[nodiscard]] auto read(std::string_view bytes, size_t offset) -> T {
+  auto value = T{};
+  std::memcpy(&value, bytes.data() + offset, sizeof(T));
+  return value;
+}
+
+// Returns a copy of the |bytes| with the |value| stored at |offset|
+[[nodiscard]] auto patched(std::string bytes, size_t offset, auto value)
+    -> std::string {
+  std::memcpy(bytes.data() + offset, &value, sizeof(value));
+  return bytes;
+}
+
 }  // namespace
 
 TEST(Tileset_Can_deduce_number_types) {
@@ -50,16 +88,46 @@ TEST(Tileset_Implements_RiskyLab_number_bug) {
   EXPECT_EQ(two_point_one, two_point_onethousand);  // ;)
 }
 
+TEST(Tileset_Can_resolve_coordinates_from_number_text) {
+  EXPECT_EQ(tilemap::internal::coordinateFrom("2.1"),
+            (Utils::Coordinate{.x = 2, .y = 1}));
+  EXPECT_EQ(tilemap::internal::coordinateFrom("0.6"),
+            (Utils::Coordinate{.x = 0, .y = 6}));
+  EXPECT_EQ(tilemap::internal::coordinateFrom("12"),
+            (Utils::Coordinate{.x = 12, .y = 0}));
+  EXPECT_EQ(tilemap::internal::coordinateFrom("1.2e1"),
+            (Utils::Coordinate{.x = 12, .y = 0}));
+  EXPECT_EQ(tilemap::internal::coordinateFrom("-1"), Utils::Coordinate{});
+  EXPECT_EQ(tilemap::internal::coordinateFrom("0"), Utils::Coordinate{});
+
+  // Unlike numbers, the number text keeps its trailing zeros.
+  EXPECT_EQ(tilemap::internal::coordinateFrom("8.10"),
+            (Utils::Coordinate{.x = 8, .y = 10}));
+}
+
 TEST(Tileset_Can_parse_JSON_tileset_map_data) {
+  constexpr auto FOUR_BY_ONE_TEST_MAP =
+      R"({"layers":[{"tileset":"MapEditor Tileset_woodland.png",
+"data":[0,1.2,2.1,3]}],"tilesets":[{"tilewidth":32,"tileheight":32}],
+"canvas":{"width":128,"height":32}})";
   const auto expected = std::vector<Utils::Coordinate>{
       {.x = 0, .y = 0}, {.x = 1, .y = 2}, {.x = 2, .y = 1}, {.x = 3, .y = 0}};
-  const auto json = json::Json::parse(R"({"data": [0, 1.2, 2.1, 3]})");
-  ASSERT_TRUE(json);
 
-  const auto coordinates =
-      tilemap::internal::coordinatesFromJsonData((*json)["data"]);
-  EXPECT_EQ(coordinates.size(), expected.size());
-  EXPECT_EQ(coordinates, expected);
+  const auto& maybe_map    = tilemap::fromJson(FOUR_BY_ONE_TEST_MAP);
+  const auto& maybe_layers = tilemap::layersFromJson(
+      FOUR_BY_ONE_TEST_MAP, tilemap::LayerSelection::all());
+  ASSERT_TRUE(maybe_map);
+  ASSERT_TRUE(maybe_layers);
+  ASSERT_TRUE(maybe_layers->second.size() == 1);
+
+  const auto& grid  = maybe_map->second;
+  const auto& layer = maybe_layers->second.front().grid;
+  EXPECT_EQ(grid.width(), expected.size());
+  EXPECT_EQ(grid.height(), 1);
+  for (const auto pos : grid.coordinates()) {
+    EXPECT_EQ(grid[pos], expected[static_cast<size_t>(pos.x)]);
+    EXPECT_EQ(layer[pos], expected[static_cast<size_t>(pos.x)]);
+  }
 }
 
 TEST(Tileset_Can_parse_minimal_asymetrical_map) {
@@ -91,3 +159,262 @@ TEST(Tileset_Can_parse_5x5_map) {
   EXPECT_EQ(grid.width(), 5);
   EXPECT_EQ(grid.height(), 5);
 }
+
+TEST(Tileset_Can_compact_map_into_palette) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto maybe_compact = tilemap::compact(grid);
+  ASSERT_TRUE(maybe_compact);
+
+  // Unit, forrest, empty and target tiles
+  const auto& compact = *maybe_compact;
+  EXPECT_EQ(compact.palette().size(), 4);
+  const auto expanded = compact.expand();
+  for (const auto pos : grid.coordinates()) EXPECT_EQ(expanded[pos], grid[pos]);
+
+  ASSERT_FALSE(compact.passable({.x = 1, .y = 0}));
+  ASSERT_TRUE(compact.passable({.x = 2, .y = 0}));
+  ASSERT_FALSE(compact.passable({.x = 5, .y = 0}));
+  EXPECT_EQ(compact.properties({}).unit_color, 1);
+  EXPECT_EQ(compact.properties({.x = 4, .y = 4}).target_color, 1);
+
+  // Tiles are interned while the map is parsed
+  auto index                = tilemap::TileIndex{};
+  const auto& maybe_decoded =
+      tilemap::compactFromJson(FIVE_BY_FIVE_TEST_MAP, index);
+  ASSERT_TRUE(maybe_decoded);
+
+  const auto& decoded = maybe_decoded->second;
+  EXPECT_EQ(decoded.palette().size(), compact.palette().size());
+  for (const auto pos : grid.coordinates())
+    EXPECT_EQ(decoded[pos], compact[pos]);
+  EXPECT_EQ(index.findAll({.x = 8, .y = 4}), grid.findAll({.x = 8, .y = 4}));
+}
+
+TEST(Tileset_Can_compact_map_with_many_distinct_tiles) {
+  auto grid = tilemap::Grid{size_t{300}, size_t{2}};
+  for (const auto pos : grid.coordinates())
+    grid[pos] = {.x = pos.x, .y = pos.y + 10};
+
+  const auto maybe_compact = tilemap::compact(grid);
+  ASSERT_TRUE(maybe_compact);
+  EXPECT_EQ(maybe_compact->palette().size(), 600);
+  const auto expanded = maybe_compact->expand();
+  for (const auto pos : grid.coordinates()) EXPECT_EQ(expanded[pos], grid[pos]);
+}
+
+TEST(Tileset_Cannot_compact_map_with_too_many_distinct_tiles) {
+  auto grid = tilemap::Grid{size_t{257}, size_t{256}};
+  for (const auto pos : grid.coordinates()) grid[pos] = pos;
+  ASSERT_TRUE(grid.width() * grid.height() > tilemap::Palette::MAX_TILES);
+  ASSERT_FALSE(tilemap::compact(grid));
+}
+
+TEST(Tileset_Can_index_tiles_while_parsing_map) {
+  auto index            = tilemap::TileIndex{};
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP, index);
+  ASSERT_TRUE(maybe_map);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto scanned       = tilemap::TileIndex{grid};
+  for (const auto& route : tilemap::woodland::UNIT_TARGETS) {
+    for (const auto tile : {route.unit_tile, route.target_tile}) {
+      EXPECT_EQ(index.find(tile), grid.find(tile));
+      EXPECT_EQ(index.findAll(tile), grid.findAll(tile));
+      EXPECT_EQ(scanned.findAll(tile), grid.findAll(tile));
+    }
+  }
+  ASSERT_TRUE(index.find(Utils::Coordinate{.x = 8, .y = 4}));
+
+  // Only unit and target tiles are indexed
+  const auto forrest = Utils::Coordinate{.x = 3, .y = 0};
+  ASSERT_FALSE(grid.findAll(forrest).empty());
+  ASSERT_TRUE(index.findAll(forrest).empty());
+  ASSERT_TRUE(scanned.findAll(forrest).empty());
+  EXPECT_EQ(index.find(Utils::Coordinate{.x = 9, .y = 9}), std::nullopt);
+}
+
+TEST(Tileset_Can_stream_map_regardless_of_member_order) {
+  const auto& maybe_map   = tilemap::fromJson(THREE_BY_ONE_TEST_MAP);
+  const auto& maybe_first = tilemap::fromJson(SIZE_FIRST_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+  ASSERT_TRUE(maybe_first);
+
+  const auto& [info, grid]             = *maybe_map;
+  const auto& [first_info, first_grid] = *maybe_first;
+  EXPECT_EQ(first_info.texture_filename, info.texture_filename);
+  EXPECT_EQ(first_grid.width(), grid.width());
+  EXPECT_EQ(first_grid.height(), grid.height());
+  for (const auto pos : grid.coordinates())
+    EXPECT_EQ(first_grid[pos], grid[pos]);
+}
+
+TEST(Tileset_Rejects_malformed_maps) {
+  const auto map = std::string_view{SIZE_FIRST_TEST_MAP};
+  ASSERT_FALSE(tilemap::fromJson(map.substr(0, map.size() - 1)));
+  ASSERT_FALSE(tilemap::fromJson(
+      R"({"canvas":{"width":96,"height":32},"layers":[{"data":[1,2,3],
+"tileset":"woodland.png"}],"tilesets":[{"tilewidth":32,"tileheight":32}],})"));
+
+  // Too many and too few tiles for the canvas
+  ASSERT_FALSE(tilemap::fromJson(
+      R"({"canvas":{"width":96,"height":32},"layers":[{"data":[1,2,3,4],
+"tileset":"woodland.png"}],"tilesets":[{"tilewidth":32,"tileheight":32}]})"));
+  ASSERT_FALSE(tilemap::fromJson(
+      R"({"canvas":{"width":96,"height":32},"layers":[{"data":[1,2],
+"tileset":"woodland.png"}],"tilesets":[{"tilewidth":32,"tileheight":32}]})"));
+}
+
+TEST(Tileset_Can_load_compiled_map) {
+  const auto& maybe_map = tilemap::fromJson(FIVE_BY_FIVE_TEST_MAP);
+  ASSERT_TRUE(maybe_map);
+
+  auto tiles              = tilemap::TileIndex{};
+  const auto& maybe_compact =
+      tilemap::compactFromJson(FIVE_BY_FIVE_TEST_MAP, tiles);
+  ASSERT_TRUE(maybe_compact);
+
+  const auto& [info, grid] = *maybe_map;
+  const auto bytes =
+      tilemap::toCompiledMap(info, maybe_compact->second, tiles);
+  ASSERT_TRUE(tilemap::isCompiledMap(bytes));
+  ASSERT_FALSE(tilemap::isCompiledMap(FIVE_BY_FIVE_TEST_MAP));
+
+  const auto compiled = tilemap::fromCompiledMap(bytes);
+  ASSERT_TRUE(compiled);
+  EXPECT_EQ(compiled->info.canvas_size, info.canvas_size);
+  EXPECT_EQ(compiled->info.tile_size, info.tile_size);
+  EXPECT_EQ(compiled->info.texture_filename, info.texture_filename);
+
+  const auto expanded = compiled->grid.expand();
+  EXPECT_EQ(expanded.width(), grid.width());
+  EXPECT_EQ(expanded.height(), grid.height());
+  for (const auto pos : grid.coordinates()) {
+    EXPECT_EQ(expanded[pos], grid[pos]);
+    EXPECT_EQ(compiled->passable.test(pos),
+              maybe_compact->second.passable(pos));
+  }
+
+  const auto index = tilemap::TileIndex{grid};
+  for (const auto& route : tilemap::woodland::UNIT_TARGETS) {
+    EXPECT_EQ(compiled->index.findAll(route.unit_tile),
+              index.findAll(route.unit_tile));
+    EXPECT_EQ(compiled->index.findAll(route.target_tile),
+              index.findAll(route.target_tile));
+  }
+
+  // Truncated files and files of another version are rejected
+  const auto truncated = std::string_view{bytes}.substr(0, bytes.size() - 8);
+  ASSERT_FALSE(tilemap::fromCompiledMap(truncated));
+  auto other_version = bytes;
+  ++other_version[4];
+  ASSERT_FALSE(tilemap::fromCompiledMap(other_version));
+
+  // Tile ids beyond the palette are rejected
+  const auto texture_size = read<uint32_t>(bytes, 32);
+  const auto palette_size = read<uint32_t>(bytes, 36);
+  const auto ids = 48 + ((texture_size + 7) / 8 * 8) + (palette_size * 8);
+  ASSERT_TRUE(tilemap::fromCompiledMap(patched(bytes, ids, uint16_t{0})));
+  ASSERT_FALSE(tilemap::fromCompiledMap(
+      patched(bytes, ids, static_cast<uint16_t>(palette_size))));
+
+  // Passability bits past the last column of a row are rejected
+  const auto passable = ids + 56;  // 25 tile ids, padded to 8 bytes
+  const auto row      = read<uint64_t>(bytes, passable + 8);
+  ASSERT_TRUE(tilemap::fromCompiledMap(patched(bytes, passable + 8, row)));
+  ASSERT_FALSE(tilemap::fromCompiledMap(
+      patched(bytes, passable + 8, row | (uint64_t{1} << 5))));
+
+  // The last index entry holds the target at (4, 4). Entries outside the map,
+  // of tiles other than units and targets, or that do not match the tile at
+  // their position are rejected.
+  const auto entry = bytes.size() - 16;
+  ASSERT_TRUE(tilemap::fromCompiledMap(patched(bytes, entry + 8, int32_t{4})));
+  ASSERT_FALSE(tilemap::fromCompiledMap(patched(bytes, entry + 8, int32_t{5})));
+  ASSERT_FALSE(
+      tilemap::fromCompiledMap(patched(bytes, entry + 12, int32_t{-1})));
+  ASSERT_FALSE(tilemap::fromCompiledMap(patched(bytes, entry + 8, int32_t{2})));
+
+  auto forrest = patched(bytes, entry, int32_t{3});
+  forrest      = patched(forrest, entry + 4, int32_t{0});
+  forrest      = patched(forrest, entry + 8, int32_t{1});
+  forrest      = patched(forrest, entry + 12, int32_t{0});
+  ASSERT_FALSE(tilemap::fromCompiledMap(forrest));
+}
+
+TEST(Tileset_Can_select_map_layers) {
+  const auto grass  = Utils::Coordinate{.x = 1, .y = 0};
+  const auto tree   = Utils::Coordinate{.x = 3, .y = 0};
+  const auto unit   = Utils::Coordinate{.x = 8, .y = 4};
+  const auto target = Utils::Coordinate{.x = 0, .y = 6};
+
+  // Only layers[0] is selected by default
+  const auto& maybe_ground = tilemap::fromJson(LAYERED_TEST_MAP);
+  ASSERT_TRUE(maybe_ground);
+  for (const auto pos : maybe_ground->second.coordinates())
+    EXPECT_EQ(maybe_ground->second[pos], grass);
+
+  const auto by_name     = tilemap::LayerSelection::parse("obstacles,units");
+  const auto by_position = tilemap::LayerSelection::parse("1,2");
+  ASSERT_TRUE(by_name);
+  ASSERT_TRUE(by_position);
+
+  auto index             = tilemap::TileIndex{};
+  const auto& maybe_map  = tilemap::fromJson(LAYERED_TEST_MAP, index, *by_name);
+  const auto& maybe_same = tilemap::fromJson(LAYERED_TEST_MAP, *by_position);
+  ASSERT_TRUE(maybe_map);
+  ASSERT_TRUE(maybe_same);
+
+  const auto& [info, grid] = *maybe_map;
+  EXPECT_EQ(info.texture_filename, "woodland.png");
+  EXPECT_EQ(grid[(Utils::Coordinate{.x = 0, .y = 0})], unit);
+  EXPECT_EQ(grid[(Utils::Coordinate{.x = 1, .y = 0})], tree);
+  EXPECT_EQ(grid[(Utils::Coordinate{.x = 2, .y = 0})], target);
+  for (const auto pos : grid.coordinates())
+    EXPECT_EQ(maybe_same->second[pos], grid[pos]);
+  EXPECT_EQ(index.find(unit), grid.find(unit));
+  EXPECT_EQ(index.find(target), grid.find(target));
+  ASSERT_TRUE(index.findAll(tree).empty());
+
+  // Tiles are only indexed while decoding if a single layer is selected
+  ASSERT_TRUE(tilemap::LayerSelection{}.single());
+  ASSERT_TRUE(tilemap::LayerSelection::parse("2")->single());
+  ASSERT_FALSE(by_name->single());
+  ASSERT_FALSE(by_position->single());
+  ASSERT_FALSE(tilemap::LayerSelection::all().single());
+
+  auto units_index = tilemap::TileIndex{};
+  ASSERT_TRUE(tilemap::fromJson(LAYERED_TEST_MAP, units_index,
+                                *tilemap::LayerSelection::parse("2")));
+  EXPECT_EQ(units_index.find(unit), grid.find(unit));
+
+  auto compact_index       = tilemap::TileIndex{};
+  const auto maybe_compact = tilemap::compactFromJson(
+      LAYERED_TEST_MAP, compact_index, *by_position);
+  ASSERT_TRUE(maybe_compact);
+  EXPECT_EQ(compact_index.find(unit), grid.find(unit));
+  EXPECT_EQ(compact_index.find(target), grid.find(target));
+  for (const auto pos : grid.coordinates())
+    EXPECT_EQ(maybe_compact->second.palette().tile(maybe_compact->second[pos]),
+              grid[pos]);
+
+  const auto& maybe_layers = tilemap::layersFromJson(
+      LAYERED_TEST_MAP, tilemap::LayerSelection::all());
+  ASSERT_TRUE(maybe_layers);
+  const auto& layers = maybe_layers->second;
+  EXPECT_EQ(layers.size(), size_t{3});
+  EXPECT_EQ(layers[1].position, size_t{1});
+  EXPECT_EQ(layers[1].name, "obstacles");
+  EXPECT_EQ(maybe_layers->first.texture_filename,
+            maybe_ground->first.texture_filename);
+  for (const auto pos : grid.coordinates())
+    EXPECT_EQ(tilemap::flatten(layers)[pos], grid[pos]);
+
+  // Selections matching no layer, or no layer at all
+  ASSERT_FALSE(tilemap::fromJson(LAYERED_TEST_MAP,
+                                 *tilemap::LayerSelection::parse("roads")));
+  ASSERT_FALSE(tilemap::LayerSelection::parse(""));
+  ASSERT_FALSE(tilemap::LayerSelection::parse("units,,ground"));
+}
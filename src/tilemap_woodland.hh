@@ -1,8 +1,12 @@
 #ifndef TILEMAP_WOODLAND_HH
 #define TILEMAP_WOODLAND_HH
 
+#include <array>
+#include <cstdint>
+
 #include "src/tilemap.hh"
 #include "utils/coordinate.hh"
+#include "utils/cost_grid.hh"
 
 namespace tilemap::woodland {
 
@@ -17,6 +21,9 @@ namespace tilemap::woodland {
 // which the editor exports as 8.1, thus loosing the trailing 0 value on the y
 // coordinate.
 
+// Maps that spell out "8.10" are decoded correctly, as tiles are decoded from
+// the number text (see internal::coordinateFrom()).
+
 constexpr auto TARGET_RED    = Utils::Coordinate{.x = 0, .y = 5};
 constexpr auto UNIT_RED      = Utils::Coordinate{.x = 8, .y = 1};
 constexpr auto TARGET_BLUE   = Utils::Coordinate{.x = 0, .y = 6};
@@ -36,6 +43,24 @@ constexpr auto UNIT_TARGETS = std::array<RouteMapping, 4>{{
     {.unit_tile = UNIT_PURPLE, .target_tile = TARGET_PURPLE},
 }};
 
+// Terrain costs of the tiles units travel across. Tiles not listed cost
+// DEFAULT_TERRAIN_COST to enter.
+constexpr auto DEFAULT_TERRAIN_COST = uint8_t{1};
+
+constexpr auto TERRAIN_COSTS = std::array<TerrainCost, 2>{{
+    {.tile = FORREST, .cost = Utils::CostGrid::IMPASSABLE},
+    {.tile = GRASS, .cost = DEFAULT_TERRAIN_COST},
+}};
+
+//
+// terrainCost() returns the cost of entering a |tile| (see TERRAIN_COSTS).
+//
+[[nodiscard]] constexpr auto terrainCost(Utils::Coordinate tile) -> uint8_t {
+  for (const auto& terrain : TERRAIN_COSTS)
+    if (terrain.tile == tile) return terrain.cost;
+  return DEFAULT_TERRAIN_COST;
+}
+
 }  // namespace tilemap::woodland
 
 #endif  // TILEMAP_WOODLAND_HH
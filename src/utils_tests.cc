@@ -0,0 +1,368 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "testrunner/testrunner.h"
+#include "utils/bucket_queue.hh"
+#include "utils/compact_path.hh"
+#include "utils/coordinate.hh"
+#include "utils/file_content.hh"
+#include "utils/flat_hash_map.hh"
+#include "utils/grid.hh"
+#include "utils/radix_heap.hh"
+
+namespace {
+
+//
+// Pops all edges off the |queue|, returning their distances in order
+//
+template <typename FRONTIER>
+[[nodiscard]] auto drain(FRONTIER& queue) -> std::vector<int> {
+  auto distances = std::vector<int>{};
+  while (!queue.empty()) {
+    distances.push_back(queue.top().distance);
+    queue.pop();
+  }
+  return distances;
+}
+
+//
+// Pushes and pops edges in the order Dijkstra's algorithm would, with edges
+// pushed |step| beyond the distance popped last. Returns true if the edges
+// were popped in ascending order.
+//
+template <typename FRONTIER>
+[[nodiscard]] auto popsInOrder(int step) -> bool {
+  auto queue = FRONTIER{};
+  queue.push({0, Utils::Coordinate{}});
+
+  auto last   = 0;
+  auto popped = 0;
+  while (!queue.empty() and popped < 1000) {
+    const auto [distance, edge] = queue.top();
+    queue.pop();
+    if (distance < last) return false;
+    last = distance;
+
+    // Vary the edge cost, as weighted terrain would
+    if (++popped % 3 != 0) {
+      queue.push({distance + step, edge});
+      queue.push({distance + (step * (popped % 7)), edge});
+    }
+  }
+  return true;
+}
+
+//
+// Writes |content| to a file of the given |name| in the temporary directory,
+// and returns the path of the file.
+//
+[[nodiscard]] auto temporaryFile(std::string_view name,
+                                 std::string_view content)
+    -> std::filesystem::path {
+  const auto path = std::filesystem::temp_directory_path() / name;
+  auto file       = std::ofstream(path, std::ios::binary | std::ios::trunc);
+  file.write(content.data(), static_cast<std::streamsize>(content.size()));
+  return path;
+}
+
+//
+// Hashes integers into only two probe chains (odd and even keys), so that most
+// keys collide.
+//
+struct ParityHash {
+  [[nodiscard]] auto operator()(int key) const -> size_t {
+    return static_cast<size_t>(key) % 2;
+  }
+};
+
+//
+// Returns true if a |width| x |height| grid stored in the given LAYOUT behaves
+// like a row-major grid; every cell holds its own row-major index.
+//
+template <typename LAYOUT>
+[[nodiscard]] auto behavesRowMajor(size_t width, size_t height) -> bool {
+  using Grid = Utils::Grid<int, Utils::OutOfBoundsPolicy::Undefined, LAYOUT>;
+  const auto indexOf = [&](Utils::Coordinate pos) {
+    return (pos.y * static_cast<int>(width)) + pos.x;
+  };
+
+  // Cells written through operator[] read back from the same coordinate
+  auto grid = Grid{width, height};
+  for (auto y = size_t{}; y < height; ++y)
+    for (auto x = size_t{}; x < width; ++x)
+      grid[x, y] = static_cast<int>((y * width) + x);
+
+  // The range constructor takes cells row by row, and coordinates() visits
+  // them in the same order
+  auto row_major = std::vector<int>(width * height);
+  for (auto index = size_t{}; index < row_major.size(); ++index)
+    row_major[index] = static_cast<int>(index);
+  const auto from_range = Grid{width, row_major};
+  if (from_range.width() != width or from_range.height() != height)
+    return false;
+
+  auto expected = 0;
+  for (const auto pos : grid.coordinates()) {
+    if (indexOf(pos) != expected++) return false;
+    if (grid[pos] != indexOf(pos) or from_range[pos] != indexOf(pos))
+      return false;
+  }
+  if (static_cast<size_t>(expected) != width * height) return false;
+
+  // Searches return coordinates in row-major order
+  const auto last = Utils::Coordinate{.x = static_cast<int>(width - 1),
+                                      .y = static_cast<int>(height - 1)};
+  grid[last]      = 0;
+  return grid.find(0) == std::optional{Utils::Coordinate{}} and
+         grid.findAll(0) == std::vector{Utils::Coordinate{}, last} and
+         !grid.find(-1);
+}
+
+//
+// Returns true if appending |coordinate| to the |path| raises an exception,
+// leaving the path unchanged.
+//
+template <typename PATH>
+[[nodiscard]] auto rejectsStep(PATH path, Utils::Coordinate coordinate)
+    -> bool {
+  const auto before = path;
+  try {
+    path.push_back(coordinate);
+  } catch (const std::invalid_argument&) {
+    return path == before;
+  }
+  return false;
+}
+
+}  // namespace
+
+TEST(Frontier_Bucket_queue_pops_shortest_edge_first) {
+  auto queue = Utils::BucketQueue<int, Utils::Coordinate>{};
+  for (const auto distance : {5, 3, 9, 3, 4, 20})
+    queue.push({distance, Utils::Coordinate{}});
+  EXPECT_EQ(queue.size(), size_t{6});
+  EXPECT_EQ(drain(queue), (std::vector<int>{3, 3, 4, 5, 9, 20}));
+  ASSERT_TRUE(queue.empty());
+
+  ASSERT_TRUE((popsInOrder<Utils::BucketQueue<int, Utils::Coordinate>>(1)));
+  ASSERT_TRUE((popsInOrder<Utils::BucketQueue<int, Utils::Coordinate>>(14)));
+}
+
+TEST(Frontier_Bucket_queue_accepts_non_monotone_pushes) {
+  auto queue = Utils::BucketQueue<int, Utils::Coordinate>{};
+  queue.push({10, Utils::Coordinate{}});
+  queue.push({12, Utils::Coordinate{}});
+  EXPECT_EQ(queue.top().distance, 10);
+  queue.pop();
+
+  // Shorter than the edge popped last, and beyond the initial bucket range
+  queue.push({2, Utils::Coordinate{}});
+  queue.push({40, Utils::Coordinate{}});
+  queue.push({11, Utils::Coordinate{}});
+  EXPECT_EQ(drain(queue), (std::vector<int>{2, 11, 12, 40}));
+}
+
+TEST(Frontier_Radix_heap_pops_shortest_edge_first) {
+  auto queue = Utils::RadixHeap<int, Utils::Coordinate>{};
+  for (const auto distance : {70000, 3, 1 << 20, 3, 255, 4096})
+    queue.push({distance, Utils::Coordinate{}});
+  EXPECT_EQ(queue.size(), size_t{6});
+  EXPECT_EQ(drain(queue),
+            (std::vector<int>{3, 3, 255, 4096, 70000, 1 << 20}));
+  ASSERT_TRUE(queue.empty());
+
+  ASSERT_TRUE((popsInOrder<Utils::RadixHeap<int, Utils::Coordinate>>(1)));
+  ASSERT_TRUE((popsInOrder<Utils::RadixHeap<int, Utils::Coordinate>>(3556)));
+}
+
+TEST(Frontier_Radix_heap_accepts_non_monotone_pushes) {
+  auto queue = Utils::RadixHeap<int, Utils::Coordinate>{};
+  queue.push({1000, Utils::Coordinate{}});
+  queue.push({5000, Utils::Coordinate{}});
+  EXPECT_EQ(queue.top().distance, 1000);
+  queue.pop();
+
+  queue.push({7, Utils::Coordinate{}});
+  queue.push({1000, Utils::Coordinate{}});
+  EXPECT_EQ(drain(queue), (std::vector<int>{7, 1000, 5000}));
+}
+
+TEST(Grid_Row_major_layout_stores_rows_in_order) {
+  using Layout = Utils::LayoutPolicy::RowMajor;
+  EXPECT_EQ(Layout::size(5, 3), size_t{15});
+  EXPECT_EQ(Layout::index(4, 2, 5, 3), size_t{14});
+  ASSERT_TRUE(behavesRowMajor<Layout>(5, 3));
+}
+
+TEST(Grid_Tiled_layout_behaves_like_row_major) {
+  using Layout = Utils::LayoutPolicy::Tiled<4>;
+  EXPECT_EQ(Layout::size(8, 8), size_t{64});
+  EXPECT_EQ(Layout::index(0, 1, 8, 8), size_t{4});
+  EXPECT_EQ(Layout::index(4, 0, 8, 8), size_t{16});
+
+  // Partial blocks are padded
+  EXPECT_EQ(Layout::size(5, 3), size_t{32});
+  ASSERT_TRUE(behavesRowMajor<Layout>(5, 3));
+  ASSERT_TRUE(behavesRowMajor<Layout>(3, 9));
+  ASSERT_TRUE(behavesRowMajor<Layout>(8, 8));
+  ASSERT_TRUE(behavesRowMajor<Utils::LayoutPolicy::Tiled<>>(17, 1));
+  ASSERT_TRUE(behavesRowMajor<Utils::LayoutPolicy::Tiled<1>>(3, 2));
+}
+
+TEST(Grid_Z_order_layout_behaves_like_row_major) {
+  using Layout = Utils::LayoutPolicy::ZOrder;
+  EXPECT_EQ(Layout::index(1, 0, 4, 4), size_t{1});
+  EXPECT_EQ(Layout::index(0, 1, 4, 4), size_t{2});
+  EXPECT_EQ(Layout::index(3, 3, 4, 4), size_t{15});
+  EXPECT_EQ(Layout::size(4, 4), size_t{16});
+  EXPECT_EQ(Layout::size(0, 4), size_t{0});
+
+  ASSERT_TRUE(behavesRowMajor<Layout>(4, 4));
+  ASSERT_TRUE(behavesRowMajor<Layout>(5, 3));
+  ASSERT_TRUE(behavesRowMajor<Layout>(2, 7));
+  ASSERT_TRUE(behavesRowMajor<Layout>(33, 1));
+}
+
+TEST(FlatHash_Map_finds_entries_across_rehashes) {
+  auto map = Utils::FlatHashMap<int, int>{};
+  for (auto key = 0; key < 1000; ++key) map[key * 7] = key;
+  EXPECT_EQ(map.size(), size_t{1000});
+
+  for (auto key = 0; key < 1000; ++key) {
+    ASSERT_TRUE(map.contains(key * 7));
+    EXPECT_EQ(map.at(key * 7), key);
+    EXPECT_EQ(map.find(key * 7)->second, key);
+  }
+  ASSERT_FALSE(map.contains(1));
+  ASSERT_TRUE(map.find(1) == map.end());
+
+  // Inserting an existing key keeps its value
+  map[7] += 10;
+  EXPECT_EQ(map.at(7), 11);
+  EXPECT_EQ(map.size(), size_t{1000});
+}
+
+TEST(FlatHash_Map_erase_shifts_back_collision_chains) {
+  auto map = Utils::FlatHashMap<int, int, ParityHash>{};
+  for (auto key = 0; key < 6; ++key) map[key] = key * 10;
+
+  // Erasing from the middle and the start of a chain keeps the rest reachable
+  EXPECT_EQ(map.erase(2), size_t{1});
+  EXPECT_EQ(map.erase(1), size_t{1});
+  EXPECT_EQ(map.erase(1), size_t{0});
+  EXPECT_EQ(map.size(), size_t{4});
+  for (const auto key : {0, 3, 4, 5}) {
+    ASSERT_TRUE(map.contains(key));
+    EXPECT_EQ(map.at(key), key * 10);
+  }
+  ASSERT_FALSE(map.contains(1));
+  ASSERT_FALSE(map.contains(2));
+
+  // Erased slots are reused
+  map[2] = 7;
+  EXPECT_EQ(map.at(2), 7);
+  EXPECT_EQ(map.at(4), 40);
+}
+
+TEST(FlatHash_Set_iterates_remaining_keys_after_erase) {
+  auto set = Utils::FlatHashSet<int, ParityHash>{1, 2, 3, 4, 5, 6, 7};
+  ASSERT_FALSE(set.insert(3));
+  EXPECT_EQ(set.erase(4), size_t{1});
+  EXPECT_EQ(set.erase(1), size_t{1});
+
+  auto keys = std::vector<int>(set.begin(), set.end());
+  std::ranges::sort(keys);
+  EXPECT_EQ(keys, (std::vector<int>{2, 3, 5, 6, 7}));
+  EXPECT_EQ(set.size(), keys.size());
+
+  set.clear();
+  ASSERT_TRUE(set.empty());
+  ASSERT_TRUE(set.begin() == set.end());
+}
+
+TEST(FlatHash_Transposed_coordinates_do_not_collide) {
+  const auto a = Utils::Coordinate{.x = 1, .y = 2};
+  const auto b = Utils::Coordinate{.x = 2, .y = 1};
+  ASSERT_TRUE(std::hash<Utils::Coordinate>{}(a) !=
+              std::hash<Utils::Coordinate>{}(b));
+
+  auto map = Utils::FlatHashMap<Utils::Coordinate, int>{};
+  map[a]   = 1;
+  map[b]   = 2;
+  EXPECT_EQ(map.size(), size_t{2});
+  EXPECT_EQ(map.at(a), 1);
+  EXPECT_EQ(map.at(b), 2);
+}
+
+TEST(FileContent_Maps_regular_files) {
+  const auto path    = temporaryFile("pathfinder_mapped.json", R"({"a":1})");
+  const auto content = Utils::FileContent::open(path);
+  ASSERT_TRUE(content);
+  ASSERT_TRUE(content->mapped());
+  EXPECT_EQ(content->text(), std::string_view{R"({"a":1})"});
+  std::filesystem::remove(path);
+}
+
+TEST(FileContent_Buffers_standard_input) {
+  // More than a single read chunk
+  const auto text    = std::string(200 * 1024, 'x') + "end";
+  auto input         = std::istringstream{text};
+  auto* stdin_buf    = std::cin.rdbuf(input.rdbuf());
+  const auto content = Utils::FileContent::open("-");
+  std::cin.rdbuf(stdin_buf);
+
+  ASSERT_TRUE(content);
+  ASSERT_FALSE(content->mapped());
+  EXPECT_EQ(content->text(), std::string_view{text});
+}
+
+TEST(FileContent_Buffers_files_that_cannot_be_mapped) {
+  const auto path  = temporaryFile("pathfinder_empty.json", "");
+  const auto empty = Utils::FileContent::open(path);
+  ASSERT_TRUE(empty);
+  ASSERT_FALSE(empty->mapped());
+  ASSERT_TRUE(empty->text().empty());
+  std::filesystem::remove(path);
+
+  // Character devices are read like pipes
+  if (std::filesystem::exists("/dev/null")) {
+    const auto device = Utils::FileContent::open("/dev/null");
+    ASSERT_TRUE(device);
+    ASSERT_FALSE(device->mapped());
+    ASSERT_TRUE(device->text().empty());
+  }
+}
+
+TEST(FileContent_Rejects_missing_files) {
+  const auto path = std::filesystem::temp_directory_path() /
+                    "pathfinder_missing" / "map.json";
+  ASSERT_FALSE(Utils::FileContent::open(path));
+}
+
+TEST(CompactPath_Rejects_steps_to_non_adjacent_coordinates) {
+  using Utils::Movement;
+  const auto start      = Utils::Coordinate{.x = 2, .y = 2};
+  const auto right      = Utils::Coordinate{.x = 3, .y = 2};
+  const auto down_right = Utils::Coordinate{.x = 3, .y = 3};
+
+  const auto orthogonal = Utils::CompactPath<Movement::Orthogonal>{start};
+  ASSERT_FALSE(rejectsStep(orthogonal, right));
+  ASSERT_TRUE(rejectsStep(orthogonal, start));
+  ASSERT_TRUE(rejectsStep(orthogonal, down_right));
+  ASSERT_TRUE(rejectsStep(orthogonal, Utils::Coordinate{.x = 4, .y = 2}));
+
+  const auto diagonal = Utils::CompactPath<Movement::Diagonal>{start};
+  ASSERT_FALSE(rejectsStep(diagonal, right));
+  ASSERT_FALSE(rejectsStep(diagonal, down_right));
+  ASSERT_TRUE(rejectsStep(diagonal, start));
+  ASSERT_TRUE(rejectsStep(diagonal, Utils::Coordinate{.x = 4, .y = 4}));
+}
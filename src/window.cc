@@ -58,7 +58,8 @@ auto Window::handleEvents() -> std::optional<Event> {
   return std::nullopt;
 }
 
-void Window::draw(const tilemap::Grid& map) {
+void Window::draw(const tilemap::Layers& background,
+                  const tilemap::Grid& map) {
   window_.clear(sf::Color::White);
 
   auto sprite = sf::Sprite(texture_);
@@ -66,10 +67,16 @@ void Window::draw(const tilemap::Grid& map) {
     sprite.setPosition(tile_.x * static_cast<float>(coordinate.x),
                        tile_.y * static_cast<float>(coordinate.y));
 
-    // For aesthetic reasons, draw grass background first :)
-    // NOTE(AE) - Background should be a separate map layer
-    sprite.setTextureRect(tileAt(tilemap::woodland::GRASS));
-    window_.draw(sprite);
+    // For aesthetic reasons, draw grass if the map has no background :)
+    if (background.empty()) {
+      sprite.setTextureRect(tileAt(tilemap::woodland::GRASS));
+      window_.draw(sprite);
+    }
+    for (const auto& layer : background) {
+      if (layer.grid[coordinate] == Utils::Coordinate{}) continue;
+      sprite.setTextureRect(tileAt(layer.grid[coordinate]));
+      window_.draw(sprite);
+    }
 
     // Now draw the sprite
     sprite.setTextureRect(tileAt(map[coordinate]));
@@ -36,7 +36,12 @@ class Window {
   auto isOpen() const -> bool;
 
   auto handleEvents() -> std::optional<Event>;
-  void draw(const tilemap::Grid& map);
+
+  //
+  // draw() renders the |background| layers (in order), followed by the |map|.
+  // Without background layers, grass is drawn underneath every tile.
+  //
+  void draw(const tilemap::Layers& background, const tilemap::Grid& map);
 };
 
 }  // namespace path_finder
@@ -0,0 +1,136 @@
+#ifndef UTILS_ASTAR_HH
+#define UTILS_ASTAR_HH
+
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "default_map.hh"
+#include "dijkstras.hh"
+#include "search_context.hh"
+
+namespace Utils {
+
+//
+// AStar provides a generic implementation of the A* path finding algorithm.
+//
+// Details:
+//   https://en.wikipedia.org/wiki/A*_search_algorithm
+//
+// In contrast to Dijkstra<>, which calculates the distance to every reachable
+// point in the graph, this algorithm calculates the lowest cost path between
+// two given points only. The search is guided towards the |goal| by the
+// |heuristic| parameter, a callable operator or function that estimates the
+// remaining distance from any given edge to the goal. The estimate must never
+// overstate the actual distance (ex. manhattan distance on a grid that only
+// allows orthogonal movement).
+//
+// The |adjacent| parameter follows the same convention as Dijkstra<>::find().
+// The FRONTIER and CONTAINERS parameters select the priority queue and hash
+// container types, as for Dijkstra<>. Monotone frontiers (ex. BucketQueue<>)
+// require a consistent heuristic.
+//
+// This function returns the same distance and previous maps as Dijkstra<>,
+// however only nodes explored before the goal was reached are included. If the
+// goal is not present in the previous map, it cannot be reached from the
+// starting point.
+//
+template <typename DISTANCE, typename EDGE,
+          template <typename, typename> typename FRONTIER = PriorityQueue,
+          typename CONTAINERS = StdHashContainers>
+  requires std::is_integral_v<DISTANCE> or std::is_floating_point_v<DISTANCE>
+struct AStar {
+  using DistanceMap = default_map<EDGE, DISTANCE, CONTAINERS>;
+  using PathMap     = typename CONTAINERS::template Map<
+      EDGE, typename CONTAINERS::template Set<EDGE>>;
+  using Edge        = WeightedEdge<DISTANCE, EDGE>;
+  using Frontier    = FRONTIER<DISTANCE, EDGE>;
+
+  [[nodiscard]] static constexpr auto find(Edge start, const EDGE& goal,
+                                           auto&& adjacent, auto&& heuristic)
+      -> std::pair<DistanceMap, PathMap> {
+    auto distances = DistanceMap{};
+    auto previous  = PathMap{};
+
+    // Queue entries are ordered by the estimated total distance (distance
+    // travelled + heuristic), not the distance travelled.
+    auto queue            = Frontier{};
+    distances[start.edge] = start.distance;
+    queue.push({start.distance + heuristic(start.edge), start.edge});
+
+    while (!queue.empty()) {
+      const auto [estimate, current] = queue.top();
+      queue.pop();
+      if (current == goal) break;
+
+      // Skip queue entries superseded by a shorter distance
+      const auto distance = distances.at_or_max(current);
+      if (distance + heuristic(current) < estimate) continue;
+
+      for (const auto [distance_to, other] : adjacent(current)) {
+        const auto candidate = distance + distance_to;
+        if (candidate < distances.at_or_max(other)) {
+          distances[other] = candidate;
+          previous[other]  = {current};
+          queue.push({candidate + heuristic(other), other});
+        } else if (candidate == distances.at_or_max(other)) {
+          previous[other].insert(current);
+        }
+      }
+    }
+
+    return std::make_pair(distances, previous);
+  }
+};
+
+//
+// GridAStar provides a variant of AStar<> for graphs whose nodes are the cells
+// of a width x height grid, which searches within a reusable SearchContext<>
+// (see GridDijkstra<>). Only a single (the first found) predecessor is stored
+// per cell.
+//
+// The results held by the returned |context| remain valid until the next search
+// using the same context.
+//
+template <typename DISTANCE,
+          template <typename, typename> typename FRONTIER = PriorityQueue>
+  requires std::is_integral_v<DISTANCE> or std::is_floating_point_v<DISTANCE>
+struct GridAStar {
+  using Context = SearchContext<DISTANCE, FRONTIER>;
+  using Edge    = WeightedEdge<DISTANCE, Coordinate>;
+
+  [[nodiscard]] static constexpr auto find(Context& context, size_t width,
+                                           size_t height, Edge start,
+                                           Coordinate goal, auto&& adjacent,
+                                           auto&& heuristic) -> const Context& {
+    context.reset(width, height);
+    context.visit(start.edge, start.distance);
+
+    auto& queue = context.frontier();
+    queue.push({start.distance + heuristic(start.edge), start.edge});
+
+    while (!queue.empty()) {
+      const auto [estimate, current] = queue.top();
+      queue.pop();
+      if (current == goal) break;
+
+      // Skip queue entries superseded by a shorter distance
+      const auto distance = context.distance(current);
+      if (distance + heuristic(current) < estimate) continue;
+
+      for (const auto [distance_to, other] : adjacent(current)) {
+        const auto candidate = distance + distance_to;
+        if (candidate < context.distance(other)) {
+          context.relax(other, candidate, current);
+          queue.push({candidate + heuristic(other), other});
+        }
+      }
+    }
+
+    return context;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_ASTAR_HH
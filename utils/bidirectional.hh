@@ -0,0 +1,163 @@
+#ifndef UTILS_BIDIRECTIONAL_HH
+#define UTILS_BIDIRECTIONAL_HH
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+#include "default_map.hh"
+#include "dijkstras.hh"
+
+namespace Utils {
+
+//
+// BidirectionalSearch provides a bidirectional variant of Dijkstra<> and
+// AStar<>, which finds the lowest cost path between two given points.
+//
+// Details:
+//   https://en.wikipedia.org/wiki/Bidirectional_search
+//
+// Two searches run side by side; one from the |start| and one from the |goal|,
+// each expanding its smaller frontier first. The best path found so far is
+// updated whenever a node is reached by both searches, and the search stops
+// as soon as neither frontier can lead to a shorter path. On open maps, the
+// two searches each cover about half the distance, and together explore
+// roughly half the area of a one-sided search.
+//
+// The |adjacent| parameter follows the same convention as Dijkstra<>::find().
+// The optional |heuristic| parameter, a callable operator or function taking
+// two nodes, estimates the remaining distance between them (see AStar<>). The
+// forward search is guided towards the goal and the backward search towards
+// the start. Monotone frontiers (ex. BucketQueue<>) require a consistent
+// heuristic.
+//
+// This function returns the path from |start| to |goal| (both included), or an
+// empty vector if the goal cannot be reached.
+//
+// The backward search traverses the same |adjacent| edges as the forward
+// search, so the graph must be undirected (i.e. every edge has the same cost in
+// both directions).
+//
+template <typename DISTANCE, typename EDGE,
+          template <typename, typename> typename FRONTIER = PriorityQueue,
+          typename CONTAINERS = StdHashContainers>
+  requires std::is_integral_v<DISTANCE> or std::is_floating_point_v<DISTANCE>
+struct BidirectionalSearch {
+  using DistanceMap = default_map<EDGE, DISTANCE, CONTAINERS>;
+  using PathMap     = typename CONTAINERS::template Map<EDGE, EDGE>;
+  using Edge        = WeightedEdge<DISTANCE, EDGE>;
+  using Frontier    = FRONTIER<DISTANCE, EDGE>;
+
+  // Bidirectional Dijkstra's algorithm
+  [[nodiscard]] static constexpr auto find(const EDGE& start, const EDGE& goal,
+                                           auto&& adjacent)
+      -> std::vector<EDGE> {
+    return search<false>(start, goal, adjacent,
+                         [](const EDGE&, const EDGE&) { return DISTANCE{}; });
+  }
+
+  // Bidirectional A* algorithm
+  [[nodiscard]] static constexpr auto find(const EDGE& start, const EDGE& goal,
+                                           auto&& adjacent, auto&& heuristic)
+      -> std::vector<EDGE> {
+    return search<true>(start, goal, adjacent, heuristic);
+  }
+
+ private:
+  static constexpr auto UNREACHED = std::numeric_limits<DISTANCE>::max();
+
+  // One of the two searches, from |origin| towards |destination|
+  struct Side {
+    EDGE origin;
+    EDGE destination;
+    DistanceMap distances{};
+    PathMap previous{};
+    Frontier queue{};
+  };
+
+  template <bool GUIDED>
+  [[nodiscard]] static constexpr auto search(const EDGE& start,
+                                             const EDGE& goal, auto&& adjacent,
+                                             auto&& heuristic)
+      -> std::vector<EDGE> {
+    if (start == goal) return {start};
+
+    auto sides = std::array<Side, 2>{
+        Side{.origin = start, .destination = goal},
+        Side{.origin = goal, .destination = start}};
+    for (auto& side : sides) {
+      side.distances[side.origin] = DISTANCE{};
+      side.queue.push({heuristic(side.origin, side.destination), side.origin});
+    }
+
+    auto best    = UNREACHED;
+    auto meeting = start;
+
+    // Once either frontier runs dry, every path through the nodes it explored
+    // has been considered.
+    while (!sides[0].queue.empty() and !sides[1].queue.empty()) {
+      // With a heuristic, queue entries are ordered by estimated total
+      // distance, so only a single frontier bounds the remaining paths.
+      const auto top = std::array{sides[0].queue.top().distance,
+                                  sides[1].queue.top().distance};
+      if (best != UNREACHED) {
+        if constexpr (GUIDED) {
+          if (top[0] >= best or top[1] >= best) break;
+        } else {
+          if (top[0] + top[1] >= best) break;
+        }
+      }
+
+      const auto forward = sides[0].queue.size() <= sides[1].queue.size();
+      auto& side         = sides[forward ? 0 : 1];
+      const auto& other  = sides[forward ? 1 : 0];
+
+      const auto [estimate, current] = side.queue.top();
+      side.queue.pop();
+
+      // Skip queue entries superseded by a shorter distance
+      const auto distance = side.distances.at_or_max(current);
+      if (distance + heuristic(current, side.destination) < estimate) continue;
+
+      for (const auto [distance_to, next] : adjacent(current)) {
+        const auto candidate = distance + distance_to;
+        if (candidate >= side.distances.at_or_max(next)) continue;
+
+        side.distances[next] = candidate;
+        side.previous[next]  = current;
+        side.queue.push({candidate + heuristic(next, side.destination), next});
+
+        const auto remaining = other.distances.at_or_max(next);
+        if (remaining != UNREACHED and candidate + remaining < best) {
+          best    = candidate + remaining;
+          meeting = next;
+        }
+      }
+    }
+
+    if (best == UNREACHED) return {};
+    return join(sides, meeting);
+  }
+
+  // Joins the paths of both searches at the |meeting| node
+  [[nodiscard]] static constexpr auto join(const std::array<Side, 2>& sides,
+                                           EDGE meeting) -> std::vector<EDGE> {
+    auto path = std::vector<EDGE>{meeting};
+    for (auto node = meeting; node != sides[0].origin;) {
+      node = sides[0].previous.at(node);
+      path.push_back(node);
+    }
+    std::ranges::reverse(path);
+
+    for (auto node = meeting; node != sides[1].origin;) {
+      node = sides[1].previous.at(node);
+      path.push_back(node);
+    }
+    return path;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_BIDIRECTIONAL_HH
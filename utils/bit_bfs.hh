@@ -0,0 +1,130 @@
+#ifndef UTILS_BIT_BFS_HH
+#define UTILS_BIT_BFS_HH
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "bit_grid.hh"
+#include "coordinate.hh"
+#include "distance_field.hh"
+
+namespace Utils {
+
+//
+// BitBfs provides a word-parallel breadth-first search for uniform cost grids
+// with orthogonal movement.
+//
+// Details:
+//   https://en.wikipedia.org/wiki/Breadth-first_search
+//
+// The search frontier, visited cells and passable cells are all kept as
+// BitGrids. Each step of the search advances the entire frontier by one cell
+// in all four directions at once, 64 cells per word operation:
+//
+//   next = (up | down | left | right) & passable & ~visited
+//
+// where left/right are the frontier rows shifted by one bit (carrying bits
+// across word boundaries), and up/down are the rows above and below. Only rows
+// within reach of the current frontier are processed.
+//
+// The inner loop operates on plain arrays of words only, which allows the
+// compiler to vectorize it for the target architecture (ex. AVX2).
+//
+// This function returns the distance from |start| to every reachable cell.
+//
+struct BitBfs {
+  [[nodiscard]] static auto find(const BitGrid& passable, Coordinate start)
+      -> DistanceField {
+    const auto width  = passable.width();
+    const auto height = passable.height();
+    const auto words  = passable.wordsPerRow();
+
+    auto distances = DistanceField{width, height};
+    if (!passable.test(start)) return distances;
+
+    auto visited  = BitGrid{width, height};
+    auto frontier = BitGrid{width, height};
+    auto next     = BitGrid{width, height};
+    const auto empty_row = std::vector<uint64_t>(words);
+
+    visited.set(start);
+    frontier.set(start);
+    distances[(static_cast<size_t>(start.y) * width) +
+              static_cast<size_t>(start.x)] = 0;
+
+    // Rows [first, last] hold the current frontier
+    auto first = static_cast<size_t>(start.y);
+    auto last  = first;
+
+    for (auto distance = uint32_t{1};; ++distance) {
+      const auto from = first == 0 ? 0 : first - 1;
+      const auto to   = std::min(last + 1, height - 1);
+
+      auto next_first = height;
+      auto next_last  = size_t{};
+
+      for (auto y = from; y <= to; ++y) {
+        const auto current = frontier.row(y);
+        const auto above =
+            y > 0 ? frontier.row(y - 1) : std::span{empty_row};
+        const auto below =
+            y + 1 < height ? frontier.row(y + 1) : std::span{empty_row};
+        const auto open = passable.row(y);
+        const auto seen = visited.row(y);
+        auto out        = next.row(y);
+
+        auto any = uint64_t{};
+        for (auto word = size_t{}; word < words; ++word) {
+          const auto carry_right =
+              word > 0 ? current[word - 1] >> (BitGrid::BITS_PER_WORD - 1) : 0;
+          const auto carry_left =
+              word + 1 < words
+                  ? current[word + 1] << (BitGrid::BITS_PER_WORD - 1)
+                  : 0;
+          const auto right = (current[word] << 1U) | carry_right;
+          const auto left  = (current[word] >> 1U) | carry_left;
+
+          out[word] = (above[word] | below[word] | left | right) & open[word] &
+                      ~seen[word];
+          any |= out[word];
+        }
+
+        if (any == 0) continue;
+        next_first = std::min(next_first, y);
+        next_last  = std::max(next_last, y);
+      }
+
+      if (next_first == height) break;
+
+      // Record distances of newly reached cells and mark them visited
+      for (auto y = next_first; y <= next_last; ++y) {
+        auto seen = visited.row(y);
+        auto out  = next.row(y);
+        for (auto word = size_t{}; word < words; ++word) {
+          seen[word] |= out[word];
+          for (auto bits = out[word]; bits != 0; bits &= bits - 1) {
+            const auto x = (word * BitGrid::BITS_PER_WORD) +
+                           static_cast<size_t>(std::countr_zero(bits));
+            distances[(y * width) + x] = distance;
+          }
+        }
+      }
+
+      // The old frontier becomes the (cleared) buffer for the next step
+      for (auto y = first; y <= last; ++y)
+        std::ranges::fill(frontier.row(y), 0);
+      std::swap(frontier, next);
+      first = next_first;
+      last  = next_last;
+    }
+
+    return distances;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_BIT_BFS_HH
@@ -0,0 +1,121 @@
+#ifndef UTILS_BIT_GRID_HH
+#define UTILS_BIT_GRID_HH
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "coordinate.hh"
+
+namespace Utils {
+
+//
+// BitGrid stores a single bit for every cell of a width x height grid.
+//
+// Each row is padded to a whole number of 64-bit words, with bit (x % 64) of
+// word (x / 64) representing column x. Padding bits are always zero. This
+// allows entire rows to be processed 64 cells at a time (see BitBfs).
+//
+class BitGrid {
+  size_t width_{};
+  size_t height_{};
+  size_t words_per_row_{};
+  std::vector<uint64_t> words_{};
+
+ public:
+  static constexpr auto BITS_PER_WORD = size_t{64};
+
+  [[nodiscard]] BitGrid(size_t width, size_t height)
+      : width_{width},
+        height_{height},
+        words_per_row_{(width + BITS_PER_WORD - 1) / BITS_PER_WORD},
+        words_(words_per_row_ * height) {}
+
+  // The |words| must be laid out as described above (see words()).
+  [[nodiscard]] BitGrid(size_t width, size_t height,
+                        std::span<const uint64_t> words)
+      : width_{width},
+        height_{height},
+        words_per_row_{(width + BITS_PER_WORD - 1) / BITS_PER_WORD},
+        words_(words.begin(), words.end()) {}
+
+  //
+  // from() returns a BitGrid with bits set for every cell for which the
+  // |predicate| returns true.
+  //
+  [[nodiscard]] static auto from(size_t width, size_t height,
+                                 auto&& predicate) -> BitGrid {
+    auto grid = BitGrid{width, height};
+    for (auto y = size_t{}; y < height; ++y)
+      for (auto x = size_t{}; x < width; ++x)
+        if (predicate(Coordinate{static_cast<int>(x), static_cast<int>(y)}))
+          grid.set({static_cast<int>(x), static_cast<int>(y)});
+    return grid;
+  }
+
+  [[nodiscard]] constexpr auto width() const { return width_; }
+
+  [[nodiscard]] constexpr auto height() const { return height_; }
+
+  [[nodiscard]] constexpr auto wordsPerRow() const { return words_per_row_; }
+
+  [[nodiscard]] constexpr auto inBounds(Coordinate coordinate) const -> bool {
+    return coordinate.x >= 0 and static_cast<size_t>(coordinate.x) < width_ and
+           coordinate.y >= 0 and static_cast<size_t>(coordinate.y) < height_;
+  }
+
+  // Returns false for coordinates outside the grid
+  [[nodiscard]] constexpr auto test(Coordinate coordinate) const -> bool {
+    if (!inBounds(coordinate)) return false;
+    const auto x = static_cast<size_t>(coordinate.x);
+    return ((row(static_cast<size_t>(coordinate.y))[x / BITS_PER_WORD] >>
+             (x % BITS_PER_WORD)) &
+            1U) != 0;
+  }
+
+  constexpr void set(Coordinate coordinate, bool value = true) {
+    const auto x    = static_cast<size_t>(coordinate.x);
+    const auto mask = uint64_t{1} << (x % BITS_PER_WORD);
+    auto& word      = row(static_cast<size_t>(coordinate.y))[x / BITS_PER_WORD];
+    word            = value ? (word | mask) : (word & ~mask);
+  }
+
+  [[nodiscard]] constexpr auto row(size_t y) const
+      -> std::span<const uint64_t> {
+    return std::span{words_}.subspan(y * words_per_row_, words_per_row_);
+  }
+
+  [[nodiscard]] constexpr auto row(size_t y) -> std::span<uint64_t> {
+    return std::span{words_}.subspan(y * words_per_row_, words_per_row_);
+  }
+
+  [[nodiscard]] constexpr auto words() const -> std::span<const uint64_t> {
+    return words_;
+  }
+
+  //
+  // hash() returns a 64-bit FNV-1a hash of the grid dimensions and content,
+  // suitable for identifying a grid across program runs.
+  //
+  [[nodiscard]] constexpr auto hash() const -> uint64_t {
+    constexpr auto FNV_OFFSET = uint64_t{14695981039346656037U};
+    constexpr auto FNV_PRIME  = uint64_t{1099511628211U};
+
+    auto result     = FNV_OFFSET;
+    const auto feed = [&](uint64_t word) {
+      for (auto byte = size_t{}; byte < sizeof(word); ++byte) {
+        result ^= (word >> (byte * 8)) & 0xFFU;
+        result *= FNV_PRIME;
+      }
+    };
+
+    feed(width_);
+    feed(height_);
+    for (const auto word : words_) feed(word);
+    return result;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_BIT_GRID_HH
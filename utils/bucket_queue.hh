@@ -0,0 +1,99 @@
+#ifndef UTILS_BUCKET_QUEUE_HH
+#define UTILS_BUCKET_QUEUE_HH
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+#include "dijkstras.hh"
+
+namespace Utils {
+
+//
+// BucketQueue<> provides a monotone priority queue for small, integral
+// distances (Dial's algorithm).
+//
+// Details:
+//   https://en.wikipedia.org/wiki/Bucket_queue
+//
+// Edges are kept in a circular array of buckets, one bucket per distance value.
+// Pushing and popping are O(1) operations, as long as the distance range of
+// queued edges (i.e. the maximum edge cost) is small. The number of buckets
+// grows as needed to accomodate the range of distances in the queue.
+//
+// BucketQueue<> is a drop-in replacement for std::priority_queue<> as a search
+// frontier. It is designed for monotone use, where edges pushed are never
+// shorter than the edge most recently popped. This always holds for Dijkstra's
+// algorithm with non-negative edge costs. Pushing an edge shorter than all
+// queued edges is supported, but requires re-distributing all queued edges.
+//
+template <typename DISTANCE, typename EDGE>
+  requires std::is_integral_v<DISTANCE>
+class BucketQueue {
+  using Edge = WeightedEdge<DISTANCE, EDGE>;
+
+  std::vector<std::vector<Edge>> buckets_{std::vector<std::vector<Edge>>(8)};
+  DISTANCE current_{};
+  DISTANCE maximum_{};
+  size_t size_{};
+
+  [[nodiscard]] constexpr auto bucketOf(DISTANCE distance) const -> size_t {
+    return static_cast<size_t>(distance) & (buckets_.size() - 1);
+  }
+
+  // Re-distributes all queued edges over a (power of two) ring of buckets
+  // large enough to hold the distance range [current_, maximum_].
+  constexpr void redistribute() {
+    const auto range = static_cast<size_t>(maximum_ - current_) + 1;
+    auto buckets     = std::vector<std::vector<Edge>>(
+        std::max(buckets_.size(), std::bit_ceil(range)));
+    std::swap(buckets, buckets_);
+    for (auto& bucket : buckets)
+      for (auto& edge : bucket)
+        buckets_[bucketOf(edge.distance)].push_back(std::move(edge));
+  }
+
+  // Advances the cursor to the next non-empty bucket
+  // This must only happen once the next edge is requested, since edges at the
+  // distance most recently popped may still be pushed.
+  constexpr void advance() {
+    if (size_ == 0) return;
+    while (buckets_[bucketOf(current_)].empty()) ++current_;
+  }
+
+ public:
+  [[nodiscard]] constexpr auto empty() const -> bool { return size_ == 0; }
+
+  [[nodiscard]] constexpr auto size() const -> size_t { return size_; }
+
+  [[nodiscard]] constexpr auto top() -> const Edge& {
+    advance();
+    return buckets_[bucketOf(current_)].back();
+  }
+
+  constexpr void push(const Edge& edge) {
+    if (size_ == 0) current_ = maximum_ = edge.distance;
+
+    if (edge.distance < current_) {
+      current_ = edge.distance;
+      redistribute();
+    } else if (edge.distance > maximum_) {
+      maximum_ = edge.distance;
+      if (static_cast<size_t>(maximum_ - current_) >= buckets_.size())
+        redistribute();
+    }
+
+    buckets_[bucketOf(edge.distance)].push_back(edge);
+    ++size_;
+  }
+
+  constexpr void pop() {
+    advance();
+    buckets_[bucketOf(current_)].pop_back();
+    --size_;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_BUCKET_QUEUE_HH
@@ -0,0 +1,168 @@
+#ifndef UTILS_COMPACT_PATH_HH
+#define UTILS_COMPACT_PATH_HH
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "coordinate.hh"
+
+namespace Utils {
+
+//
+// CompactPath<> stores a path across a grid as its starting coordinate,
+// followed by a single step direction per move.
+//
+// Each direction takes up 2 bits for orthogonal movement (up, down, left,
+// right), or 3 bits if diagonal movement is allowed, packed into 64-bit words.
+// A path of N steps thus takes about N / 4 (or 3 * N / 8) bytes, rather than
+// 8 * N bytes as a std::vector<Coordinate>.
+//
+// Iterating the path yields every coordinate along it (starting coordinate
+// first), just like the std::vector<Coordinate> returned by ex.
+// path_finder::tracePath(), without decompressing the path into memory.
+//
+// Consecutive coordinates must be adjacent (see Movement); push_back() raises
+// an exception otherwise.
+//
+template <Movement MOVEMENT = Movement::Orthogonal>
+class CompactPath {
+  static constexpr auto BITS           = MOVEMENT == Movement::Diagonal ? 3 : 2;
+  static constexpr auto MASK           = (uint64_t{1} << BITS) - 1;
+  static constexpr auto STEPS_PER_WORD = size_t{64 / BITS};
+
+  // Step directions, in neighborsUpDownLeftRight() then neighorsDiagonal()
+  // order
+  static constexpr auto STEPS = std::array<Coordinate, 8>{
+      Coordinate{0, -1}, {0, 1}, {-1, 0}, {1, 0},
+      {-1, -1},          {1, 1}, {1, -1}, {-1, 1}};
+
+  // Maps a step, indexed by (dy + 1) * 3 + (dx + 1), to its direction
+  static constexpr auto DIRECTIONS = std::array<uint8_t, 9>{
+      4, 0, 6,  // Up-left, up, up-right
+      2, 0, 3,  // Left, (none), right
+      7, 1, 5   // Down-left, down, down-right
+  };
+
+  Coordinate start_{};
+  size_t size_{};
+  Coordinate back_{};
+  std::vector<uint64_t> steps_{};
+
+  // Returns true if |step| moves to a neighbor reachable in a single move
+  [[nodiscard]] static constexpr auto isStep(Coordinate step) -> bool {
+    const auto dx = std::abs(step.x);
+    const auto dy = std::abs(step.y);
+    if constexpr (MOVEMENT == Movement::Diagonal)
+      return dx <= 1 and dy <= 1 and dx + dy != 0;
+    return dx + dy == 1;
+  }
+
+  [[nodiscard]] constexpr auto step(size_t index) const -> Coordinate {
+    const auto word  = steps_[index / STEPS_PER_WORD];
+    const auto shift = (index % STEPS_PER_WORD) * BITS;
+    return STEPS[(word >> shift) & MASK];
+  }
+
+ public:
+  class Iterator {
+    const CompactPath* path_{};
+    size_t index_{};
+    Coordinate current_{};
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Coordinate;
+    using difference_type   = std::ptrdiff_t;
+
+    [[nodiscard]] constexpr Iterator() = default;
+
+    [[nodiscard]] constexpr Iterator(const CompactPath* path, size_t index)
+        : path_{path}, index_{index}, current_{path->start_} {}
+
+    [[nodiscard]] constexpr auto operator*() const -> Coordinate {
+      return current_;
+    }
+
+    constexpr auto operator++() -> Iterator& {
+      // Step |index_| leads from coordinate |index_| to the next
+      if (++index_ < path_->size_) current_ += path_->step(index_ - 1);
+      return *this;
+    }
+
+    constexpr auto operator++(int) -> Iterator {
+      auto previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const Iterator& other) const
+        -> bool {
+      return index_ == other.index_;
+    }
+  };
+
+  [[nodiscard]] constexpr CompactPath() = default;
+
+  [[nodiscard]] explicit constexpr CompactPath(Coordinate start)
+      : start_{start}, size_{1}, back_{start} {}
+
+  //
+  // from() compacts the given range of |coordinates|, ex. the result of
+  // path_finder::tracePath().
+  //
+  [[nodiscard]] static constexpr auto from(const auto& coordinates)
+      -> CompactPath {
+    auto path = CompactPath{};
+    for (const auto coordinate : coordinates) path.push_back(coordinate);
+    return path;
+  }
+
+  // Appends |coordinate|, which must be adjacent to back() (if any). Throws
+  // std::invalid_argument if it is not.
+  constexpr void push_back(Coordinate coordinate) {
+    if (size_ == 0) {
+      start_ = back_ = coordinate;
+      size_  = 1;
+      return;
+    }
+
+    const auto step = coordinate - back_;
+    if (!isStep(step))
+      throw std::invalid_argument("CompactPath: Coordinate is not adjacent");
+
+    const auto direction = DIRECTIONS[((step.y + 1) * 3) + step.x + 1];
+    const auto index     = size_++ - 1;
+    if (index % STEPS_PER_WORD == 0) steps_.push_back(0);
+    steps_.back() |= uint64_t{direction} << ((index % STEPS_PER_WORD) * BITS);
+    back_ = coordinate;
+  }
+
+  // Returns the number of coordinates along the path (i.e. steps + 1)
+  [[nodiscard]] constexpr auto size() const { return size_; }
+
+  [[nodiscard]] constexpr auto empty() const { return size_ == 0; }
+
+  // Only valid if the path is not empty.
+  [[nodiscard]] constexpr auto front() const { return start_; }
+  [[nodiscard]] constexpr auto back() const { return back_; }
+
+  [[nodiscard]] constexpr auto begin() const { return Iterator{this, 0}; }
+  [[nodiscard]] constexpr auto end() const { return Iterator{this, size_}; }
+
+  // Returns the number of bytes used to store the steps of the path
+  [[nodiscard]] constexpr auto stepBytes() const -> size_t {
+    return steps_.size() * sizeof(uint64_t);
+  }
+
+  [[nodiscard]] constexpr auto operator==(const CompactPath& other) const
+      -> bool = default;
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_COMPACT_PATH_HH
@@ -4,6 +4,7 @@
 #include <array>
 #include <cmath>
 #include <compare>  // IWYU pragma: keep
+#include <cstdint>
 #include <type_traits>
 #include <vector>  // IWYU pragma: keep - Included for std::hash
 
@@ -124,6 +125,15 @@ struct CoordinateBase {
 //
 using Coordinate = CoordinateBase<int>;
 
+//
+// Movement defines the directions a unit may travel on a uniform cost grid.
+//
+// Orthogonal movement allows travel up, down, left and right only. Diagonal
+// movement additionally allows diagonal travel (ex. in JumpPointSearch<>, as
+// long as both orthogonal cells next to the diagonal step are passable).
+//
+enum class Movement : uint8_t { Orthogonal, Diagonal };
+
 }  // namespace Utils
 
 namespace std {
@@ -133,11 +143,19 @@ namespace std {
 // Utils::Coordinate with std::unordered_map<>, std::unordered_set<> and similar
 // types.
 //
+// Both components are packed into a single 64-bit value, which is then mixed
+// (splitmix64 finalizer), so that ex. (1, 2) and (2, 1) do not collide.
+//
 template <>
 struct hash<Utils::Coordinate> {
   [[nodiscard]] auto operator()(
       const Utils::Coordinate& coordinate) const noexcept -> size_t {
-    return std::hash<int>()(coordinate.x) ^ std::hash<int>()(coordinate.y);
+    auto packed = (static_cast<uint64_t>(static_cast<uint32_t>(coordinate.x))
+                   << 32U) |
+                  static_cast<uint32_t>(coordinate.y);
+    packed = (packed ^ (packed >> 30U)) * 0xBF58476D1CE4E5B9U;
+    packed = (packed ^ (packed >> 27U)) * 0x94D049BB133111EBU;
+    return static_cast<size_t>(packed ^ (packed >> 31U));
   }
 };
 
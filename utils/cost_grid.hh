@@ -0,0 +1,77 @@
+#ifndef UTILS_COST_GRID_HH
+#define UTILS_COST_GRID_HH
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "coordinate.hh"
+
+namespace Utils {
+
+//
+// CostGrid stores the cost of entering every cell of a width x height grid, as
+// a single byte per cell in one contiguous vector, indexed by (y * width + x).
+//
+// Costs range from 1 to 254. Cells that cannot be entered hold the IMPASSABLE
+// sentinel, which is also reported for all coordinates outside the grid. This
+// way, weighing a step of a search takes a single load, rather than resolving
+// the terrain of the cell (see NeighborhoodPolicy<>::adjacent()).
+//
+class CostGrid {
+  size_t width_{};
+  size_t height_{};
+  std::vector<uint8_t> costs_{};
+
+  [[nodiscard]] constexpr auto indexOf(Coordinate coordinate) const -> size_t {
+    return (static_cast<size_t>(coordinate.y) * width_) +
+           static_cast<size_t>(coordinate.x);
+  }
+
+ public:
+  static constexpr auto IMPASSABLE = std::numeric_limits<uint8_t>::max();
+
+  [[nodiscard]] CostGrid(size_t width, size_t height)
+      : width_{width}, height_{height}, costs_(width * height, IMPASSABLE) {}
+
+  //
+  // from() returns a CostGrid holding the result of the |cost| callable for
+  // every cell.
+  //
+  [[nodiscard]] static auto from(size_t width, size_t height, auto&& cost)
+      -> CostGrid {
+    auto grid = CostGrid{width, height};
+    for (auto y = size_t{}; y < height; ++y)
+      for (auto x = size_t{}; x < width; ++x)
+        grid.set({static_cast<int>(x), static_cast<int>(y)},
+                 cost(Coordinate{static_cast<int>(x), static_cast<int>(y)}));
+    return grid;
+  }
+
+  [[nodiscard]] constexpr auto width() const { return width_; }
+
+  [[nodiscard]] constexpr auto height() const { return height_; }
+
+  [[nodiscard]] constexpr auto inBounds(Coordinate coordinate) const -> bool {
+    return coordinate.x >= 0 and static_cast<size_t>(coordinate.x) < width_ and
+           coordinate.y >= 0 and static_cast<size_t>(coordinate.y) < height_;
+  }
+
+  // Returns IMPASSABLE for coordinates outside the grid
+  [[nodiscard]] constexpr auto cost(Coordinate coordinate) const -> uint8_t {
+    return inBounds(coordinate) ? costs_[indexOf(coordinate)] : IMPASSABLE;
+  }
+
+  [[nodiscard]] constexpr auto passable(Coordinate coordinate) const -> bool {
+    return cost(coordinate) != IMPASSABLE;
+  }
+
+  // Unchecked access; |coordinate| must be within the grid.
+  constexpr void set(Coordinate coordinate, uint8_t cost) {
+    costs_[indexOf(coordinate)] = cost;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_COST_GRID_HH
@@ -0,0 +1,213 @@
+#ifndef UTILS_D_STAR_LITE_HH
+#define UTILS_D_STAR_LITE_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "bit_grid.hh"
+#include "coordinate.hh"
+
+namespace Utils {
+
+//
+// DStarLite provides an implementation of the D* Lite incremental path finding
+// algorithm for uniform cost grids with orthogonal movement.
+//
+// Details:
+//   https://en.wikipedia.org/wiki/D*
+//   http://idm-lab.org/bib/abstracts/papers/aaai02b.pdf
+//
+// The search runs backwards from the |goal| towards the |start|, in the same
+// way as A*. In contrast to A*, the search state is kept between queries. When
+// the start moves (moveTo()) or cells of the grid change (update()), only the
+// part of the search affected by the change is repaired on the next call to
+// path(). The cost of replanning thus scales with the size of the change, not
+// the size of the grid.
+//
+class DStarLite {
+  using Key = std::pair<int, int>;
+
+  static constexpr auto INFINITE = std::numeric_limits<int>::max();
+
+  // Queue entries hold the key and cell index, min element first
+  struct Entry {
+    Key key;
+    size_t index;
+
+    [[nodiscard]] constexpr auto operator<(const Entry& other) const -> bool {
+      // Reverse ordering - min element first
+      return other.key < key;
+    }
+  };
+
+  BitGrid passable_;
+  Coordinate start_{};
+  Coordinate goal_{};
+  Coordinate last_{};
+  int offset_{};  // Accumulated heuristic offset ("km") for start movement
+
+  std::vector<int> g_{};
+  std::vector<int> rhs_{};
+
+  // The queue does not support removal or key updates. Instead, |queued_| holds
+  // the current key of each queued cell and entries with a different key are
+  // skipped as stale.
+  std::priority_queue<Entry> queue_{};
+  std::vector<Key> queued_{};
+  std::vector<bool> in_queue_{};
+
+  [[nodiscard]] constexpr auto indexOf(Coordinate coordinate) const -> size_t {
+    return (static_cast<size_t>(coordinate.y) * passable_.width()) +
+           static_cast<size_t>(coordinate.x);
+  }
+
+  [[nodiscard]] constexpr auto coordinateOf(size_t index) const -> Coordinate {
+    return {.x = static_cast<int>(index % passable_.width()),
+            .y = static_cast<int>(index / passable_.width())};
+  }
+
+  [[nodiscard]] static constexpr auto add(int lhs, int rhs) -> int {
+    return lhs == INFINITE or rhs == INFINITE ? INFINITE : lhs + rhs;
+  }
+
+  // Cost of moving between two neighboring cells
+  [[nodiscard]] constexpr auto cost(Coordinate from, Coordinate to) const
+      -> int {
+    return passable_.test(from) and passable_.test(to) ? 1 : INFINITE;
+  }
+
+  [[nodiscard]] auto keyOf(size_t index) const -> Key {
+    const auto distance = std::min(g_[index], rhs_[index]);
+    const auto estimate =
+        coordinateOf(index).manhattanDistanceFrom(start_) + offset_;
+    return {add(distance, estimate), distance};
+  }
+
+  void enqueue(size_t index) {
+    queued_[index]   = keyOf(index);
+    in_queue_[index] = true;
+    queue_.push({queued_[index], index});
+  }
+
+  // Discards stale entries; returns false if the queue is empty
+  auto prune() -> bool {
+    while (!queue_.empty()) {
+      const auto [key, index] = queue_.top();
+      if (in_queue_[index] and queued_[index] == key) return true;
+      queue_.pop();
+    }
+    return false;
+  }
+
+  void updateCell(Coordinate cell) {
+    if (!passable_.inBounds(cell)) return;
+    const auto index = indexOf(cell);
+    if (cell != goal_) {
+      rhs_[index] = INFINITE;
+      for (const auto next : cell.neighborsUpDownLeftRight())
+        if (passable_.inBounds(next))
+          rhs_[index] =
+              std::min(rhs_[index], add(cost(cell, next), g_[indexOf(next)]));
+    }
+    in_queue_[index] = false;
+    if (g_[index] != rhs_[index]) enqueue(index);
+  }
+
+  void computeShortestPath() {
+    const auto start = indexOf(start_);
+    while (prune() and
+           (queue_.top().key < keyOf(start) or rhs_[start] != g_[start])) {
+      const auto [key, index] = queue_.top();
+      queue_.pop();
+      in_queue_[index] = false;
+
+      const auto cell = coordinateOf(index);
+      if (key < keyOf(index)) {
+        enqueue(index);
+      } else if (g_[index] > rhs_[index]) {
+        g_[index] = rhs_[index];
+        for (const auto next : cell.neighborsUpDownLeftRight())
+          updateCell(next);
+      } else {
+        g_[index] = INFINITE;
+        updateCell(cell);
+        for (const auto next : cell.neighborsUpDownLeftRight())
+          updateCell(next);
+      }
+    }
+  }
+
+ public:
+  [[nodiscard]] DStarLite(BitGrid passable, Coordinate start, Coordinate goal)
+      : passable_{std::move(passable)},
+        start_{start},
+        goal_{goal},
+        last_{start},
+        g_(passable_.width() * passable_.height(), INFINITE),
+        rhs_(passable_.width() * passable_.height(), INFINITE),
+        queued_(passable_.width() * passable_.height()),
+        in_queue_(passable_.width() * passable_.height()) {
+    // path() returns an empty vector for a goal outside the grid
+    if (!passable_.inBounds(goal_)) return;
+    rhs_[indexOf(goal_)] = 0;
+    enqueue(indexOf(goal_));
+  }
+
+  //
+  // moveTo() moves the start of the search (ex. after a unit has advanced
+  // along its path).
+  //
+  void moveTo(Coordinate start) {
+    offset_ += last_.manhattanDistanceFrom(start);
+    start_ = start;
+    last_  = start;
+  }
+
+  //
+  // update() changes whether a single |cell| is passable. The search is
+  // repaired on the next call to path().
+  //
+  void update(Coordinate cell, bool passable) {
+    if (!passable_.inBounds(cell) or passable_.test(cell) == passable) return;
+    passable_.set(cell, passable);
+    updateCell(cell);
+    for (const auto next : cell.neighborsUpDownLeftRight()) updateCell(next);
+  }
+
+  //
+  // path() returns the full, step-by-step path from the start to the goal
+  // (both included), or an empty vector if the goal cannot be reached.
+  //
+  [[nodiscard]] auto path() -> std::vector<Coordinate> {
+    if (!passable_.test(start_) or !passable_.test(goal_)) return {};
+    computeShortestPath();
+    if (g_[indexOf(start_)] == INFINITE) return {};
+
+    // Follow the lowest cost neighbors from the start down to the goal. A
+    // path never visits a cell twice, so the walk is bounded by the number of
+    // cells in case the costs are inconsistent.
+    auto path = std::vector<Coordinate>{start_};
+    while (path.back() != goal_) {
+      if (path.size() == g_.size()) return {};
+
+      const auto from = path.back();
+      auto best       = std::pair{INFINITE, from};
+      for (const auto next : from.neighborsUpDownLeftRight()) {
+        if (!passable_.inBounds(next)) continue;
+        best = std::min(
+            best, std::pair{add(cost(from, next), g_[indexOf(next)]), next});
+      }
+      if (best.first == INFINITE) return {};
+      path.push_back(best.second);
+    }
+    return path;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_D_STAR_LITE_HH
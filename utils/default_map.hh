@@ -3,17 +3,35 @@
 
 #include <limits>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace Utils {
 
 //
-// default_map<KEY, VALUE> defines a simple wrapper around std::unordered_map,
-// offering s single convenience member functino 'at_or_max()', which returns
-// the numerically maximal value if a given key does not exist.
+// StdHashContainers selects std::unordered_map<> and std::unordered_set<> as
+// the containers used by the graph searches (ex. Dijkstra<>). This is the
+// default; see FlatHashContainers for an alternative.
 //
-template <typename KEY, typename VALUE>
+struct StdHashContainers {
+  template <typename KEY, typename VALUE>
+  using Map = std::unordered_map<KEY, VALUE>;
+
+  template <typename KEY>
+  using Set = std::unordered_set<KEY>;
+};
+
+//
+// default_map<KEY, VALUE> defines a simple wrapper around a hash map, offering
+// s single convenience member functino 'at_or_max()', which returns the
+// numerically maximal value if a given key does not exist.
+//
+// The CONTAINERS parameter selects the underlying map type; std::unordered_map
+// by default (see StdHashContainers).
+//
+template <typename KEY, typename VALUE,
+          typename CONTAINERS = StdHashContainers>
   requires std::is_integral_v<VALUE> or std::is_floating_point_v<VALUE>
-class default_map : public std::unordered_map<KEY, VALUE> {
+class default_map : public CONTAINERS::template Map<KEY, VALUE> {
   static inline VALUE max_ = std::numeric_limits<VALUE>::max();
 
  public:
@@ -30,6 +30,17 @@ struct WeightedEdge {
   }
 };
 
+//
+// PriorityQueue<> defines the default search frontier; a binary heap ordered by
+// WeightedEdge<> distance.
+//
+// Search algorithms accept the frontier type as a template parameter. For
+// integral distances, the monotone BucketQueue<> and RadixHeap<> types are
+// available as alternatives.
+//
+template <typename DISTANCE, typename EDGE>
+using PriorityQueue = std::priority_queue<WeightedEdge<DISTANCE, EDGE>>;
+
 //
 // dijkstra() provides a generic implementation of Dijkstra's path finding
 // algorithm.
@@ -51,19 +62,28 @@ struct WeightedEdge {
 // If a given edge is not present in either the distances or previous maps, the
 // starting point cannot be reached from that graph lcoation.
 //
-template <typename DISTANCE, typename EDGE>
+// The FRONTIER template parameter selects the priority queue type used to pick
+// the next edge to explore (see PriorityQueue<> above). The CONTAINERS
+// parameter selects the hash map and set types backing the returned maps (see
+// StdHashContainers and FlatHashContainers).
+//
+template <typename DISTANCE, typename EDGE,
+          template <typename, typename> typename FRONTIER = PriorityQueue,
+          typename CONTAINERS = StdHashContainers>
   requires std::is_integral_v<DISTANCE> or std::is_floating_point_v<DISTANCE>
 struct Dijkstra {
-  using DistanceMap = default_map<EDGE, DISTANCE>;
-  using PathMap     = std::unordered_map<EDGE, std::unordered_set<EDGE>>;
+  using DistanceMap = default_map<EDGE, DISTANCE, CONTAINERS>;
+  using PathMap     = typename CONTAINERS::template Map<
+      EDGE, typename CONTAINERS::template Set<EDGE>>;
   using Edge        = WeightedEdge<DISTANCE, EDGE>;
+  using Frontier    = FRONTIER<DISTANCE, EDGE>;
 
   [[nodiscard]] static constexpr auto find(Edge start, auto&& adjacent)
       -> std::pair<DistanceMap, PathMap> {
     auto distances = DistanceMap{};
     auto previous  = PathMap{};
 
-    auto queue = std::priority_queue<Edge>{};
+    auto queue = Frontier{};
     queue.push(start);
 
     while (!queue.empty()) {
@@ -0,0 +1,99 @@
+#ifndef UTILS_DISTANCE_FIELD_HH
+#define UTILS_DISTANCE_FIELD_HH
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "coordinate.hh"
+
+namespace Utils {
+
+//
+// BasicDistanceField<> stores the (uniform cost, orthogonal) distance from a
+// single starting point for every cell of a width x height grid, indexed by
+// (y * width + x).
+//
+// Rather than storing predecessors, the previous cell on the shortest path
+// back to the starting point is derived from the distances: it is the first
+// neighbor (in neighborsUpDownLeftRight() order) one step closer to the start.
+// This provides the same contains()/at() interface as GridDijkstra<>::PathMap.
+//
+// The STORAGE parameter selects whether the distances are owned by the field
+// (DistanceField) or held elsewhere, ex. in a memory mapped file
+// (DistanceFieldView).
+//
+template <typename STORAGE>
+class BasicDistanceField {
+  size_t width_{};
+  size_t height_{};
+  STORAGE distances_{};
+
+  [[nodiscard]] constexpr auto indexOf(Coordinate coordinate) const -> size_t {
+    return (static_cast<size_t>(coordinate.y) * width_) +
+           static_cast<size_t>(coordinate.x);
+  }
+
+ public:
+  static constexpr auto UNREACHED = std::numeric_limits<uint32_t>::max();
+
+  [[nodiscard]] BasicDistanceField(size_t width, size_t height)
+    requires std::is_same_v<STORAGE, std::vector<uint32_t>>
+      : width_{width}, height_{height}, distances_(width * height, UNREACHED) {}
+
+  // |distances| must hold (width * height) values.
+  [[nodiscard]] constexpr BasicDistanceField(size_t width, size_t height,
+                                             STORAGE distances)
+      : width_{width}, height_{height}, distances_{std::move(distances)} {}
+
+  [[nodiscard]] constexpr auto width() const { return width_; }
+
+  [[nodiscard]] constexpr auto height() const { return height_; }
+
+  [[nodiscard]] constexpr auto inBounds(Coordinate coordinate) const -> bool {
+    return coordinate.x >= 0 and static_cast<size_t>(coordinate.x) < width_ and
+           coordinate.y >= 0 and static_cast<size_t>(coordinate.y) < height_;
+  }
+
+  [[nodiscard]] constexpr auto contains(Coordinate coordinate) const -> bool {
+    return inBounds(coordinate) and
+           distances_[indexOf(coordinate)] != UNREACHED;
+  }
+
+  // Returns UNREACHED for cells that cannot be reached or are out of bounds
+  [[nodiscard]] constexpr auto distance(Coordinate coordinate) const
+      -> uint32_t {
+    return inBounds(coordinate) ? distances_[indexOf(coordinate)] : UNREACHED;
+  }
+
+  // Only valid if contains(coordinate) returns true. The starting point itself
+  // has no previous cell and is returned as-is.
+  [[nodiscard]] constexpr auto at(Coordinate coordinate) const -> Coordinate {
+    const auto distance = distances_[indexOf(coordinate)];
+    for (const auto neighbor : coordinate.neighborsUpDownLeftRight())
+      if (distance != 0 and this->distance(neighbor) == distance - 1)
+        return neighbor;
+    return coordinate;
+  }
+
+  // Unchecked access; |index| must be within the grid.
+  [[nodiscard]] constexpr auto operator[](size_t index) -> uint32_t&
+    requires std::is_same_v<STORAGE, std::vector<uint32_t>>
+  {
+    return distances_[index];
+  }
+
+  [[nodiscard]] constexpr auto data() const -> std::span<const uint32_t> {
+    return distances_;
+  }
+};
+
+using DistanceField     = BasicDistanceField<std::vector<uint32_t>>;
+using DistanceFieldView = BasicDistanceField<std::span<const uint32_t>>;
+
+}  // namespace Utils
+
+#endif  // UTILS_DISTANCE_FIELD_HH
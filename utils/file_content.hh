@@ -0,0 +1,77 @@
+#ifndef UTILS_FILE_CONTENT_HH
+#define UTILS_FILE_CONTENT_HH
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <istream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+#include "mapped_file.hh"
+
+namespace Utils {
+
+//
+// FileContent provides the entire content of a file as a single, read-only
+// std::string_view (see text()), for as long as the object lives.
+//
+// Regular files are memory mapped (see MappedFile), so their content is never
+// copied. Files that cannot be mapped (ex. pipes, character devices or empty
+// files) are read into a buffer instead, as is the standard input if the
+// |path| is "-".
+//
+// Returns std::nullopt from open() if the file does not exist or could not be
+// read.
+//
+class FileContent {
+  std::variant<MappedFile, std::string> content_;
+
+  [[nodiscard]] explicit FileContent(MappedFile file)
+      : content_{std::move(file)} {}
+
+  [[nodiscard]] explicit FileContent(std::string buffer)
+      : content_{std::move(buffer)} {}
+
+  // Reads the |stream| to its end, in large chunks
+  [[nodiscard]] static auto readAll(std::istream& stream) -> std::string {
+    auto buffer = std::string{};
+    auto chunk  = std::array<char, 64 * 1024>{};
+    while (stream.read(chunk.data(), chunk.size()) or stream.gcount() > 0)
+      buffer.append(chunk.data(), static_cast<size_t>(stream.gcount()));
+    return buffer;
+  }
+
+ public:
+  [[nodiscard]] static auto open(const std::filesystem::path& path)
+      -> std::optional<FileContent> {
+    if (path == "-") return FileContent{readAll(std::cin)};
+    if (auto file = MappedFile::open(path))
+      return FileContent{std::move(*file)};
+
+    auto stream = std::ifstream(path, std::ios::binary);
+    if (!stream) return std::nullopt;
+    return FileContent{readAll(stream)};
+  }
+
+  // Returns true if the content is memory mapped rather than buffered
+  [[nodiscard]] auto mapped() const -> bool {
+    return std::holds_alternative<MappedFile>(content_);
+  }
+
+  [[nodiscard]] auto text() const -> std::string_view {
+    if (const auto* buffer = std::get_if<std::string>(&content_))
+      return *buffer;
+
+    const auto bytes = std::get<MappedFile>(content_).bytes();
+    return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_FILE_CONTENT_HH
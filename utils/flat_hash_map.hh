@@ -0,0 +1,287 @@
+#ifndef UTILS_FLAT_HASH_MAP_HH
+#define UTILS_FLAT_HASH_MAP_HH
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Utils {
+
+//
+// FlatHashTable<> provides the open-addressing hash table underlying
+// FlatHashMap<> and FlatHashSet<>.
+//
+// All entries are stored in a single contiguous vector of slots, rather than
+// one heap allocated node per entry as in std::unordered_map<>. Collisions are
+// resolved by linear probing, and the table doubles in size once it is 7/8
+// full. Erased entries are removed by shifting back the following entries of
+// the probe sequence, so no tombstones are left behind.
+//
+// Hash values are scrambled (Fibonacci hashing) before selecting a slot, so
+// even weak hash functions (ex. the identity hash of integers) spread well.
+//
+// Keys and values must be default constructible. Any insertion may invalidate
+// iterators and references into the table.
+//
+template <typename KEY, typename SLOT, typename HASH>
+class FlatHashTable {
+  static constexpr auto MIN_CAPACITY = size_t{8};
+
+  std::vector<SLOT> slots_{};
+  std::vector<uint8_t> used_{};
+  size_t size_{};
+  size_t shift_{};
+
+ protected:
+  [[nodiscard]] static constexpr auto keyOf(const SLOT& slot) -> const KEY& {
+    if constexpr (std::is_same_v<SLOT, KEY>) {
+      return slot;
+    } else {
+      return slot.first;
+    }
+  }
+
+  [[nodiscard]] constexpr auto home(const KEY& key) const -> size_t {
+    const auto hash = static_cast<uint64_t>(HASH{}(key));
+    return static_cast<size_t>((hash * 0x9E3779B97F4A7C15U) >> shift_);
+  }
+
+  [[nodiscard]] constexpr auto next(size_t slot) const -> size_t {
+    return (slot + 1) & (slots_.size() - 1);
+  }
+
+  // Returns the slot holding |key|, or slots_.size() if not present
+  [[nodiscard]] constexpr auto slotOf(const KEY& key) const -> size_t {
+    if (slots_.empty()) return 0;
+    for (auto slot = home(key); used_[slot] != 0; slot = next(slot))
+      if (keyOf(slots_[slot]) == key) return slot;
+    return slots_.size();
+  }
+
+  void rehash(size_t capacity) {
+    auto slots = std::exchange(slots_, std::vector<SLOT>(capacity));
+    auto used  = std::exchange(used_, std::vector<uint8_t>(capacity));
+    shift_     = 64 - static_cast<size_t>(std::countr_zero(capacity));
+    size_      = 0;
+    for (auto slot = size_t{}; slot < slots.size(); ++slot)
+      if (used[slot] != 0) emplaceSlot(std::move(slots[slot]));
+  }
+
+  // Inserts |key| (if not present) and returns its slot index
+  auto insertKey(const KEY& key) -> std::pair<size_t, bool> {
+    if ((size_ + 1) * 8 > slots_.size() * 7)
+      rehash(std::max(MIN_CAPACITY, slots_.size() * 2));
+
+    auto slot = home(key);
+    for (; used_[slot] != 0; slot = next(slot))
+      if (keyOf(slots_[slot]) == key) return {slot, false};
+
+    used_[slot] = 1;
+    if constexpr (std::is_same_v<SLOT, KEY>) {
+      slots_[slot] = key;
+    } else {
+      slots_[slot] = SLOT{key, {}};
+    }
+    ++size_;
+    return {slot, true};
+  }
+
+  void emplaceSlot(SLOT&& value) {
+    auto slot = home(keyOf(value));
+    while (used_[slot] != 0) slot = next(slot);
+    used_[slot]  = 1;
+    slots_[slot] = std::move(value);
+    ++size_;
+  }
+
+  [[nodiscard]] constexpr auto capacity() const { return slots_.size(); }
+
+  [[nodiscard]] constexpr auto slot(size_t index) -> SLOT& {
+    return slots_[index];
+  }
+
+  [[nodiscard]] constexpr auto slot(size_t index) const -> const SLOT& {
+    return slots_[index];
+  }
+
+ public:
+  template <bool CONST>
+  class Iterator {
+    using Table =
+        std::conditional_t<CONST, const FlatHashTable, FlatHashTable>;
+
+    Table* table_{};
+    size_t slot_{};
+
+    constexpr void skipUnused() {
+      while (slot_ < table_->slots_.size() and table_->used_[slot_] == 0)
+        ++slot_;
+    }
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = SLOT;
+    using difference_type   = std::ptrdiff_t;
+    using reference = std::conditional_t<CONST, const SLOT&, SLOT&>;
+
+    [[nodiscard]] constexpr Iterator() = default;
+
+    [[nodiscard]] constexpr Iterator(Table* table, size_t slot)
+        : table_{table}, slot_{slot} {
+      skipUnused();
+    }
+
+    [[nodiscard]] constexpr auto operator*() const -> reference {
+      return table_->slots_[slot_];
+    }
+
+    [[nodiscard]] constexpr auto operator->() const { return &**this; }
+
+    constexpr auto operator++() -> Iterator& {
+      ++slot_;
+      skipUnused();
+      return *this;
+    }
+
+    constexpr auto operator++(int) -> Iterator {
+      auto previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const Iterator& other) const
+        -> bool {
+      return slot_ == other.slot_;
+    }
+  };
+
+  using iterator       = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  [[nodiscard]] auto begin() { return iterator{this, 0}; }
+  [[nodiscard]] auto end() { return iterator{this, slots_.size()}; }
+  [[nodiscard]] auto begin() const { return const_iterator{this, 0}; }
+  [[nodiscard]] auto end() const {
+    return const_iterator{this, slots_.size()};
+  }
+
+  [[nodiscard]] constexpr auto size() const { return size_; }
+
+  [[nodiscard]] constexpr auto empty() const { return size_ == 0; }
+
+  [[nodiscard]] constexpr auto contains(const KEY& key) const -> bool {
+    return slotOf(key) != slots_.size();
+  }
+
+  void clear() {
+    slots_.clear();
+    used_.clear();
+    size_ = 0;
+  }
+
+  void reserve(size_t count) {
+    const auto capacity =
+        std::bit_ceil(std::max(MIN_CAPACITY, (count * 8 / 7) + 1));
+    if (capacity > slots_.size()) rehash(capacity);
+  }
+
+  // Returns the number of erased entries (0 or 1)
+  auto erase(const KEY& key) -> size_t {
+    auto hole = slotOf(key);
+    if (hole == slots_.size()) return 0;
+
+    // Shift back following entries that would otherwise become unreachable
+    for (auto slot = next(hole); used_[slot] != 0; slot = next(slot)) {
+      const auto wanted = home(keyOf(slots_[slot]));
+      if (((slot - wanted) & (slots_.size() - 1)) >=
+          ((slot - hole) & (slots_.size() - 1))) {
+        slots_[hole] = std::move(slots_[slot]);
+        hole         = slot;
+      }
+    }
+    used_[hole]  = 0;
+    slots_[hole] = SLOT{};
+    --size_;
+    return 1;
+  }
+};
+
+//
+// FlatHashMap<> provides an open-addressing hash map (see FlatHashTable<>),
+// offering the commonly used subset of the std::unordered_map<> interface.
+//
+template <typename KEY, typename VALUE, typename HASH = std::hash<KEY>>
+class FlatHashMap : public FlatHashTable<KEY, std::pair<KEY, VALUE>, HASH> {
+  using Table = FlatHashTable<KEY, std::pair<KEY, VALUE>, HASH>;
+
+ public:
+  using key_type    = KEY;
+  using mapped_type = VALUE;
+  using value_type  = std::pair<KEY, VALUE>;
+
+  [[nodiscard]] auto operator[](const KEY& key) -> VALUE& {
+    return this->slot(this->insertKey(key).first).second;
+  }
+
+  [[nodiscard]] auto at(const KEY& key) -> VALUE& {
+    return const_cast<VALUE&>(std::as_const(*this).at(key));
+  }
+
+  [[nodiscard]] auto at(const KEY& key) const -> const VALUE& {
+    const auto slot = this->slotOf(key);
+    if (slot == this->capacity()) throw std::out_of_range("FlatHashMap::at");
+    return this->slot(slot).second;
+  }
+
+  [[nodiscard]] auto find(const KEY& key) {
+    return typename Table::iterator{this, this->slotOf(key)};
+  }
+
+  [[nodiscard]] auto find(const KEY& key) const {
+    return typename Table::const_iterator{this, this->slotOf(key)};
+  }
+};
+
+//
+// FlatHashSet<> provides an open-addressing hash set (see FlatHashTable<>),
+// offering the commonly used subset of the std::unordered_set<> interface.
+//
+template <typename KEY, typename HASH = std::hash<KEY>>
+class FlatHashSet : public FlatHashTable<KEY, KEY, HASH> {
+ public:
+  using key_type   = KEY;
+  using value_type = KEY;
+
+  [[nodiscard]] FlatHashSet() = default;
+
+  [[nodiscard]] FlatHashSet(std::initializer_list<KEY> keys) {
+    for (const auto& key : keys) insert(key);
+  }
+
+  // Returns true if the |key| was inserted (i.e. was not present before)
+  auto insert(const KEY& key) -> bool { return this->insertKey(key).second; }
+};
+
+//
+// FlatHashContainers selects FlatHashMap<> and FlatHashSet<> as the containers
+// used by the graph searches (ex. Dijkstra<>); see StdHashContainers.
+//
+struct FlatHashContainers {
+  template <typename KEY, typename VALUE>
+  using Map = FlatHashMap<KEY, VALUE>;
+
+  template <typename KEY>
+  using Set = FlatHashSet<KEY>;
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_FLAT_HASH_MAP_HH
@@ -2,9 +2,12 @@
 #define UTILS_GRID_HH
 
 #include <cmath>
+#include <cstdint>
 #include <optional>
 #include <ranges>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "coordinate.hh"
@@ -46,28 +49,125 @@ struct Throw {
 
 };  // namespace Utils::OutOfBoundsPolicy
 
+namespace Utils::LayoutPolicy {
+
+//
+// LayoutPolicy::RowMajor stores grid cells row by row (default).
+//
+struct RowMajor {
+  [[nodiscard]] static constexpr auto size(size_t width, size_t height)
+      -> size_t {
+    return width * height;
+  }
+
+  [[nodiscard]] static constexpr auto index(size_t x, size_t y, size_t width,
+                                            size_t /*height*/) -> size_t {
+    return (y * width) + x;
+  }
+};
+
+//
+// LayoutPolicy::Tiled stores grid cells in square blocks of BLOCK x BLOCK
+// cells, each stored row by row. Blocks themselves are stored row by row.
+//
+// Vertical neighbors within a block are only BLOCK cells apart, rather than a
+// full row of the grid.
+//
+template <size_t BLOCK = 8>
+  requires(BLOCK > 0)
+struct Tiled {
+  [[nodiscard]] static constexpr auto blocks(size_t cells) -> size_t {
+    return (cells + BLOCK - 1) / BLOCK;
+  }
+
+  [[nodiscard]] static constexpr auto size(size_t width, size_t height)
+      -> size_t {
+    return blocks(width) * blocks(height) * BLOCK * BLOCK;
+  }
+
+  [[nodiscard]] static constexpr auto index(size_t x, size_t y, size_t width,
+                                            size_t /*height*/) -> size_t {
+    const auto block = ((y / BLOCK) * blocks(width)) + (x / BLOCK);
+    return (block * BLOCK * BLOCK) + ((y % BLOCK) * BLOCK) + (x % BLOCK);
+  }
+};
+
+//
+// LayoutPolicy::ZOrder stores grid cells in Morton (Z-order) sequence, by
+// interleaving the bits of the x and y coordinates.
+//
+// Details:
+//   https://en.wikipedia.org/wiki/Z-order_curve
+//
+// Cells close to each other in both dimensions are stored close together at
+// every scale. Storage is padded up to the Morton index of the bottom right
+// cell, so this layout is best suited for (roughly) square grids.
+//
+struct ZOrder {
+  [[nodiscard]] static constexpr auto spread(size_t value) -> size_t {
+    auto bits = static_cast<uint64_t>(value) & 0xFFFFFFFFU;
+    bits      = (bits | (bits << 16U)) & 0x0000FFFF0000FFFFU;
+    bits      = (bits | (bits << 8U)) & 0x00FF00FF00FF00FFU;
+    bits      = (bits | (bits << 4U)) & 0x0F0F0F0F0F0F0F0FU;
+    bits      = (bits | (bits << 2U)) & 0x3333333333333333U;
+    bits      = (bits | (bits << 1U)) & 0x5555555555555555U;
+    return static_cast<size_t>(bits);
+  }
+
+  [[nodiscard]] static constexpr auto size(size_t width, size_t height)
+      -> size_t {
+    if (width == 0 or height == 0) return 0;
+    return index(width - 1, height - 1, width, height) + 1;
+  }
+
+  [[nodiscard]] static constexpr auto index(size_t x, size_t y,
+                                            size_t /*width*/,
+                                            size_t /*height*/) -> size_t {
+    return spread(x) | (spread(y) << 1U);
+  }
+};
+
+}  // namespace Utils::LayoutPolicy
+
 namespace Utils {
 
 //
 // Grid helper class, inspired by Sy Brand
 // --> https://github.com/TartanLlama/aoc-2024/blob/main/src/grid.hpp
 //
-template <typename STORE_AS, typename OOB_POLICY = OutOfBoundsPolicy::Undefined>
+// The LAYOUT policy determines the order in which cells are stored in memory
+// (see LayoutPolicy). Regardless of layout, coordinates() and the algorithms
+// below traverse the grid row by row.
+//
+template <typename STORE_AS, typename OOB_POLICY = OutOfBoundsPolicy::Undefined,
+          typename LAYOUT = LayoutPolicy::RowMajor>
 class Grid {
   size_t width_{};
   size_t height_{};
   std::vector<STORE_AS> data_{};
 
+  [[nodiscard]] constexpr auto indexOf(size_t x, size_t y) const -> size_t {
+    return LAYOUT::index(x, y, width_, height_);
+  }
+
  public:
   // Constructors
 
   [[nodiscard]] Grid(size_t width, size_t height)
-      : width_{width}, height_{height}, data_(width * height) {}
+      : width_{width}, height_{height}, data_(LAYOUT::size(width, height)) {}
 
+  // The |input_range| is expected in row by row order.
   template <typename CHARACTER_RANGE>
   [[nodiscard]] Grid(size_t width, CHARACTER_RANGE&& input_range)
       : width_{width}, data_{std::begin(input_range), std::end(input_range)} {
     height_ = data_.size() / width_;
+    if constexpr (!std::is_same_v<LAYOUT, LayoutPolicy::RowMajor>) {
+      auto row_major = std::exchange(
+          data_, std::vector<STORE_AS>(LAYOUT::size(width_, height_)));
+      for (auto y = size_t{}; y < height_; ++y)
+        for (auto x = size_t{}; x < width_; ++x)
+          data_[indexOf(x, y)] = std::move(row_major[(y * width_) + x]);
+    }
   }
 
   // Data access
@@ -77,7 +177,7 @@ class Grid {
       if (!inBounds(Coordinate{static_cast<int>(x), static_cast<int>(y)}))
         return OOB_POLICY::outOfBounds();
     }
-    return data_[(y * width_) + x];
+    return data_[indexOf(x, y)];
   }
 
   [[nodiscard]] constexpr auto operator[](size_t x, size_t y) const
@@ -86,15 +186,15 @@ class Grid {
       if (!inBounds(Coordinate{static_cast<int>(x), static_cast<int>(y)}))
         return OOB_POLICY::outOfBounds();
     }
-    return data_[(y * width_) + x];
+    return data_[indexOf(x, y)];
   }
 
   [[nodiscard]] constexpr auto operator[](Coordinate coordinate) -> STORE_AS& {
     if constexpr (OOB_POLICY::check_bounds) {
       if (!inBounds(coordinate)) return OOB_POLICY::outOfBounds();
     }
-    return data_[(static_cast<size_t>(coordinate.y) * width_) +
-                 static_cast<size_t>(coordinate.x)];
+    return data_[indexOf(static_cast<size_t>(coordinate.x),
+                         static_cast<size_t>(coordinate.y))];
   }
 
   [[nodiscard]] constexpr auto operator[](Coordinate coordinate) const
@@ -102,8 +202,8 @@ class Grid {
     if constexpr (OOB_POLICY::check_bounds) {
       if (!inBounds(coordinate)) return OOB_POLICY::outOfBounds();
     }
-    return data_[(static_cast<size_t>(coordinate.y) * width_) +
-                 static_cast<size_t>(coordinate.x)];
+    return data_[indexOf(static_cast<size_t>(coordinate.x),
+                         static_cast<size_t>(coordinate.y))];
   }
 
   // Utility
@@ -0,0 +1,191 @@
+#ifndef UTILS_GRID_DIJKSTRA_HH
+#define UTILS_GRID_DIJKSTRA_HH
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "coordinate.hh"
+#include "dijkstras.hh"
+#include "search_context.hh"
+
+namespace Utils {
+
+//
+// FlatDistanceMap<> stores a distance value for every cell of a width x height
+// grid in a single contiguous vector, indexed by (y * width + x).
+//
+// Mirroring default_map<>, cells that have not been assigned a distance report
+// the numerically maximal value through at_or_max().
+//
+template <typename DISTANCE>
+  requires std::is_integral_v<DISTANCE> or std::is_floating_point_v<DISTANCE>
+class FlatDistanceMap {
+  static constexpr auto MAX = std::numeric_limits<DISTANCE>::max();
+
+  size_t width_{};
+  size_t height_{};
+  std::vector<DISTANCE> distances_{};
+
+  [[nodiscard]] constexpr auto indexOf(Coordinate coordinate) const -> size_t {
+    return (static_cast<size_t>(coordinate.y) * width_) +
+           static_cast<size_t>(coordinate.x);
+  }
+
+ public:
+  [[nodiscard]] FlatDistanceMap(size_t width, size_t height)
+      : width_{width}, height_{height}, distances_(width * height, MAX) {}
+
+  [[nodiscard]] constexpr auto inBounds(Coordinate coordinate) const -> bool {
+    return coordinate.x >= 0 and static_cast<size_t>(coordinate.x) < width_ and
+           coordinate.y >= 0 and static_cast<size_t>(coordinate.y) < height_;
+  }
+
+  [[nodiscard]] constexpr auto contains(Coordinate coordinate) const -> bool {
+    return inBounds(coordinate) and distances_[indexOf(coordinate)] != MAX;
+  }
+
+  [[nodiscard]] constexpr auto at_or_max(Coordinate coordinate) const
+      -> DISTANCE {
+    return inBounds(coordinate) ? distances_[indexOf(coordinate)] : MAX;
+  }
+
+  // Unchecked access; |coordinate| must be within the grid.
+  [[nodiscard]] constexpr auto operator[](Coordinate coordinate) -> DISTANCE& {
+    return distances_[indexOf(coordinate)];
+  }
+};
+
+//
+// FlatPathMap stores the predecessor of every cell of a width x height grid as
+// a flat 32-bit cell index in a single contiguous vector, indexed by
+// (y * width + x).
+//
+// The interface mirrors the parts of std::unordered_map<> used to trace paths
+// (contains() and at()), except that each cell holds exactly one predecessor.
+//
+class FlatPathMap {
+  static constexpr auto NONE = std::numeric_limits<uint32_t>::max();
+
+  size_t width_{};
+  size_t height_{};
+  std::vector<uint32_t> previous_{};
+
+  [[nodiscard]] constexpr auto indexOf(Coordinate coordinate) const -> size_t {
+    return (static_cast<size_t>(coordinate.y) * width_) +
+           static_cast<size_t>(coordinate.x);
+  }
+
+ public:
+  [[nodiscard]] FlatPathMap(size_t width, size_t height)
+      : width_{width}, height_{height}, previous_(width * height, NONE) {}
+
+  [[nodiscard]] constexpr auto inBounds(Coordinate coordinate) const -> bool {
+    return coordinate.x >= 0 and static_cast<size_t>(coordinate.x) < width_ and
+           coordinate.y >= 0 and static_cast<size_t>(coordinate.y) < height_;
+  }
+
+  [[nodiscard]] constexpr auto contains(Coordinate coordinate) const -> bool {
+    return inBounds(coordinate) and previous_[indexOf(coordinate)] != NONE;
+  }
+
+  // Only valid if contains(coordinate) returns true.
+  [[nodiscard]] constexpr auto at(Coordinate coordinate) const -> Coordinate {
+    const auto index = previous_[indexOf(coordinate)];
+    return {.x = static_cast<int>(index % width_),
+            .y = static_cast<int>(index / width_)};
+  }
+
+  constexpr void set(Coordinate coordinate, Coordinate previous) {
+    previous_[indexOf(coordinate)] = static_cast<uint32_t>(indexOf(previous));
+  }
+};
+
+//
+// GridDijkstra provides a variant of Dijkstra<> specialized for graphs whose
+// nodes are the cells of a width x height grid (ex. tilemap::Grid).
+//
+// Instead of hash maps, distances and predecessors are kept in flat vectors
+// indexed by (y * width + x), so every relaxation is a direct array access.
+// Only a single (the first found) predecessor is stored per cell.
+//
+// The |adjacent| parameter follows the same convention as Dijkstra<>::find(),
+// but must only yield coordinates inside the grid. The FRONTIER parameter
+// selects the priority queue type, as for Dijkstra<>.
+//
+// For repeated searches, find() can run within a reusable SearchContext<>
+// rather than allocating new distance and path maps for every search.
+//
+template <typename DISTANCE,
+          template <typename, typename> typename FRONTIER = PriorityQueue>
+  requires std::is_integral_v<DISTANCE> or std::is_floating_point_v<DISTANCE>
+struct GridDijkstra {
+  using DistanceMap = FlatDistanceMap<DISTANCE>;
+  using PathMap     = FlatPathMap;
+  using Edge        = WeightedEdge<DISTANCE, Coordinate>;
+  using Frontier    = FRONTIER<DISTANCE, Coordinate>;
+  using Context     = SearchContext<DISTANCE, FRONTIER>;
+
+  [[nodiscard]] static constexpr auto find(size_t width, size_t height,
+                                           Edge start, auto&& adjacent)
+      -> std::pair<DistanceMap, PathMap> {
+    auto distances = DistanceMap{width, height};
+    auto previous  = PathMap{width, height};
+
+    auto queue            = Frontier{};
+    distances[start.edge] = start.distance;
+    queue.push(start);
+
+    while (!queue.empty()) {
+      const auto [distance, current] = queue.top();
+      queue.pop();
+
+      // Skip queue entries superseded by a shorter distance
+      if (distances.at_or_max(current) < distance) continue;
+
+      for (const auto [distance_to, other] : adjacent(current)) {
+        if (distance + distance_to < distances.at_or_max(other)) {
+          distances[other] = distance + distance_to;
+          previous.set(other, current);
+          queue.push({distances[other], other});
+        }
+      }
+    }
+
+    return std::make_pair(std::move(distances), std::move(previous));
+  }
+
+  // The results held by the returned |context| remain valid until the next
+  // search using the same context.
+  [[nodiscard]] static constexpr auto find(Context& context, size_t width,
+                                           size_t height, Edge start,
+                                           auto&& adjacent) -> const Context& {
+    context.reset(width, height);
+    context.visit(start.edge, start.distance);
+
+    auto& queue = context.frontier();
+    queue.push(start);
+
+    while (!queue.empty()) {
+      const auto [distance, current] = queue.top();
+      queue.pop();
+
+      // Skip queue entries superseded by a shorter distance
+      if (context.distance(current) < distance) continue;
+
+      for (const auto [distance_to, other] : adjacent(current)) {
+        if (distance + distance_to < context.distance(other)) {
+          context.relax(other, distance + distance_to, current);
+          queue.push({distance + distance_to, other});
+        }
+      }
+    }
+
+    return context;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_GRID_DIJKSTRA_HH
@@ -0,0 +1,325 @@
+#ifndef UTILS_HIERARCHICAL_ASTAR_HH
+#define UTILS_HIERARCHICAL_ASTAR_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "astar.hh"
+#include "bit_grid.hh"
+#include "coordinate.hh"
+#include "dijkstras.hh"
+
+namespace Utils {
+
+//
+// HierarchicalAStar provides an implementation of the HPA* (Hierarchical Path
+// finding A*) algorithm for uniform cost grids with orthogonal movement.
+//
+// Details:
+//   https://webdocs.cs.ualberta.ca/~mmueller/ps/hpastar.pdf
+//
+// On construction, the grid is partitioned into square clusters of
+// |cluster_size| cells. Entrances are placed along the borders between
+// neighboring clusters, and the distances between all entrances of a cluster
+// are precomputed. This abstract graph is built once and can then be reused
+// for any number of queries on the same grid.
+//
+// A query connects the start and goal to the entrances of their respective
+// clusters, searches the (much smaller) abstract graph using AStar<>, and then
+// refines the abstract path into a step-by-step path. Only the clusters along
+// the abstract path are searched at cell level.
+//
+// Paths are near-optimal; entrances restrict where a path may cross a cluster
+// border, which can make paths slightly longer than the shortest.
+//
+class HierarchicalAStar {
+  using Edge = WeightedEdge<int, size_t>;
+
+  // Border runs at least this long receive an entrance at both ends
+  static constexpr auto WIDE_ENTRANCE = size_t{6};
+
+  BitGrid passable_;
+  size_t cluster_size_{};
+  size_t clusters_x_{};
+  size_t clusters_y_{};
+
+  std::vector<Coordinate> nodes_{};
+  std::unordered_map<Coordinate, size_t> node_index_{};
+  std::vector<std::vector<Edge>> edges_{};
+  std::vector<std::vector<size_t>> cluster_nodes_{};
+
+  //
+  // ClusterSearch holds the result of a breadth-first search from a single
+  // cell, confined to the cluster containing that cell.
+  //
+  class ClusterSearch {
+    static constexpr auto NONE = std::numeric_limits<uint32_t>::max();
+
+    Coordinate origin_{};
+    size_t width_{};
+    size_t height_{};
+    std::vector<uint32_t> distances_{};
+    std::vector<uint32_t> previous_{};
+
+    [[nodiscard]] constexpr auto indexOf(Coordinate coordinate) const
+        -> size_t {
+      return (static_cast<size_t>(coordinate.y - origin_.y) * width_) +
+             static_cast<size_t>(coordinate.x - origin_.x);
+    }
+
+    [[nodiscard]] constexpr auto coordinateOf(size_t index) const
+        -> Coordinate {
+      return {.x = origin_.x + static_cast<int>(index % width_),
+              .y = origin_.y + static_cast<int>(index / width_)};
+    }
+
+   public:
+    [[nodiscard]] ClusterSearch(const HierarchicalAStar& graph, Coordinate from)
+        : origin_{graph.clusterOrigin(from)} {
+      const auto end = graph.clusterEnd(from);
+      width_         = static_cast<size_t>(end.x - origin_.x);
+      height_        = static_cast<size_t>(end.y - origin_.y);
+      distances_.assign(width_ * height_, NONE);
+      previous_.assign(width_ * height_, NONE);
+
+      const auto inCluster = [&](Coordinate coordinate) {
+        return coordinate.x >= origin_.x and coordinate.x < end.x and
+               coordinate.y >= origin_.y and coordinate.y < end.y and
+               graph.passable_.test(coordinate);
+      };
+
+      auto queue                = std::queue<Coordinate>{};
+      distances_[indexOf(from)] = 0;
+      queue.push(from);
+      while (!queue.empty()) {
+        const auto current = queue.front();
+        queue.pop();
+        const auto distance = distances_[indexOf(current)];
+        for (const auto next : current.neighborsUpDownLeftRight()) {
+          if (!inCluster(next) or distances_[indexOf(next)] != NONE) continue;
+          distances_[indexOf(next)] = distance + 1;
+          previous_[indexOf(next)]  = static_cast<uint32_t>(indexOf(current));
+          queue.push(next);
+        }
+      }
+    }
+
+    // |to| must be within the searched cluster.
+    [[nodiscard]] constexpr auto reached(Coordinate to) const -> bool {
+      return distances_[indexOf(to)] != NONE;
+    }
+
+    [[nodiscard]] constexpr auto distance(Coordinate to) const -> int {
+      return static_cast<int>(distances_[indexOf(to)]);
+    }
+
+    // Returns the path to |to|, excluding the cell the search started from
+    [[nodiscard]] auto pathTo(Coordinate to) const -> std::vector<Coordinate> {
+      auto path = std::vector<Coordinate>{};
+      for (auto index = indexOf(to); previous_[index] != NONE;
+           index      = previous_[index])
+        path.push_back(coordinateOf(index));
+      std::ranges::reverse(path);
+      return path;
+    }
+  };
+
+  [[nodiscard]] constexpr auto clusterOf(Coordinate coordinate) const
+      -> size_t {
+    const auto x = static_cast<size_t>(coordinate.x) / cluster_size_;
+    const auto y = static_cast<size_t>(coordinate.y) / cluster_size_;
+    return (y * clusters_x_) + x;
+  }
+
+  [[nodiscard]] constexpr auto clusterOrigin(Coordinate coordinate) const
+      -> Coordinate {
+    const auto size = static_cast<int>(cluster_size_);
+    return {.x = coordinate.x / size * size, .y = coordinate.y / size * size};
+  }
+
+  [[nodiscard]] constexpr auto clusterEnd(Coordinate coordinate) const
+      -> Coordinate {
+    const auto origin = clusterOrigin(coordinate);
+    const auto size   = static_cast<int>(cluster_size_);
+    return {
+        .x = std::min(origin.x + size, static_cast<int>(passable_.width())),
+        .y = std::min(origin.y + size, static_cast<int>(passable_.height()))};
+  }
+
+  auto addNode(Coordinate coordinate) -> size_t {
+    const auto [it, inserted] =
+        node_index_.try_emplace(coordinate, nodes_.size());
+    if (inserted) {
+      nodes_.push_back(coordinate);
+      edges_.emplace_back();
+      cluster_nodes_[clusterOf(coordinate)].push_back(it->second);
+    }
+    return it->second;
+  }
+
+  // Adds a pair of connected entrance nodes on either side of a border
+  void addEntrance(Coordinate inside, Coordinate outside) {
+    const auto from = addNode(inside);
+    const auto to   = addNode(outside);
+    edges_[from].push_back({1, to});
+    edges_[to].push_back({1, from});
+  }
+
+  //
+  // Scans the border between two neighboring clusters, starting at |first|
+  // (the first cell of the border on the near side) and advancing by |along|.
+  // The cells on the far side of the border are at offset |across|.
+  //
+  void addEntrances(Coordinate first, Coordinate along, Coordinate across,
+                    size_t length) {
+    const auto addRun = [&](Coordinate start, size_t run) {
+      if (run == 0) return;
+      if (run < WIDE_ENTRANCE) {
+        const auto middle = start + (along * static_cast<int>(run / 2));
+        addEntrance(middle, middle + across);
+        return;
+      }
+      const auto last = start + (along * static_cast<int>(run - 1));
+      addEntrance(start, start + across);
+      addEntrance(last, last + across);
+    };
+
+    auto run_start = first;
+    auto run       = size_t{};
+    for (auto step = size_t{}; step < length; ++step) {
+      const auto at = first + (along * static_cast<int>(step));
+      if (passable_.test(at) and passable_.test(at + across)) {
+        if (run++ == 0) run_start = at;
+        continue;
+      }
+      addRun(run_start, run);
+      run = 0;
+    }
+    addRun(run_start, run);
+  }
+
+  // Connects all nodes of a |cluster| by their distance within the cluster
+  void connectCluster(size_t cluster) {
+    for (const auto from : cluster_nodes_[cluster]) {
+      const auto search = ClusterSearch{*this, nodes_[from]};
+      for (const auto to : cluster_nodes_[cluster]) {
+        if (to == from or !search.reached(nodes_[to])) continue;
+        edges_[from].push_back({search.distance(nodes_[to]), to});
+      }
+    }
+  }
+
+ public:
+  [[nodiscard]] HierarchicalAStar(BitGrid passable, size_t cluster_size)
+      : passable_{std::move(passable)},
+        cluster_size_{cluster_size},
+        clusters_x_{(passable_.width() + cluster_size - 1) / cluster_size},
+        clusters_y_{(passable_.height() + cluster_size - 1) / cluster_size},
+        cluster_nodes_(clusters_x_ * clusters_y_) {
+    const auto width  = passable_.width();
+    const auto height = passable_.height();
+
+    for (auto y = size_t{}; y < height; y += cluster_size) {
+      for (auto x = size_t{}; x < width; x += cluster_size) {
+        const auto origin =
+            Coordinate{.x = static_cast<int>(x), .y = static_cast<int>(y)};
+        const auto end = clusterEnd(origin);
+
+        // Right border
+        if (static_cast<size_t>(end.x) < width)
+          addEntrances({.x = end.x - 1, .y = origin.y}, {.x = 0, .y = 1},
+                       {.x = 1, .y = 0}, static_cast<size_t>(end.y - origin.y));
+
+        // Bottom border
+        if (static_cast<size_t>(end.y) < height)
+          addEntrances({.x = origin.x, .y = end.y - 1}, {.x = 1, .y = 0},
+                       {.x = 0, .y = 1}, static_cast<size_t>(end.x - origin.x));
+      }
+    }
+
+    for (auto cluster = size_t{}; cluster < cluster_nodes_.size(); ++cluster)
+      connectCluster(cluster);
+  }
+
+  // Number of entrance nodes in the abstract graph
+  [[nodiscard]] constexpr auto nodeCount() const { return nodes_.size(); }
+
+  //
+  // find() returns the full, step-by-step path from |start| to |goal| (both
+  // included), or an empty vector if the goal cannot be reached.
+  //
+  [[nodiscard]] auto find(Coordinate start, Coordinate goal) const
+      -> std::vector<Coordinate> {
+    if (!passable_.test(start) or !passable_.test(goal)) return {};
+    if (start == goal) return {start};
+
+    // The start and goal are added to the abstract graph as two temporary nodes
+    // past the end of the node list, leaving the precomputed graph untouched.
+    const auto start_node = nodes_.size();
+    const auto goal_node  = nodes_.size() + 1;
+    const auto positionOf = [&](size_t node) {
+      if (node == start_node) return start;
+      if (node == goal_node) return goal;
+      return nodes_[node];
+    };
+
+    const auto from_start = ClusterSearch{*this, start};
+    const auto from_goal  = ClusterSearch{*this, goal};
+    auto start_edges      = std::vector<Edge>{};
+    auto goal_edges       = std::unordered_map<size_t, int>{};
+    for (const auto node : cluster_nodes_[clusterOf(start)])
+      if (from_start.reached(nodes_[node]))
+        start_edges.push_back({from_start.distance(nodes_[node]), node});
+    for (const auto node : cluster_nodes_[clusterOf(goal)])
+      if (from_goal.reached(nodes_[node]))
+        goal_edges[node] = from_goal.distance(nodes_[node]);
+    if (clusterOf(start) == clusterOf(goal) and from_start.reached(goal))
+      start_edges.push_back({from_start.distance(goal), goal_node});
+
+    const auto adjacent = [&](size_t node) {
+      if (node == goal_node) return std::vector<Edge>{};
+      auto result = node == start_node ? start_edges : edges_[node];
+      if (goal_edges.contains(node))
+        result.push_back({goal_edges.at(node), goal_node});
+      return result;
+    };
+    const auto heuristic = [&](size_t node) {
+      return positionOf(node).manhattanDistanceFrom(goal);
+    };
+
+    const auto [_, previous] = AStar<int, size_t>::find(
+        {0, start_node}, goal_node, adjacent, heuristic);
+    if (!previous.contains(goal_node)) return {};
+
+    auto abstract = std::vector<Coordinate>{goal};
+    for (auto node = goal_node; node != start_node;) {
+      node = *previous.at(node).begin();
+      abstract.push_back(positionOf(node));
+    }
+    std::ranges::reverse(abstract);
+
+    // Refine each abstract step into cell steps
+    auto path = std::vector<Coordinate>{start};
+    for (auto step = size_t{1}; step < abstract.size(); ++step) {
+      const auto from = abstract[step - 1];
+      const auto to   = abstract[step];
+      if (clusterOf(from) != clusterOf(to)) {
+        path.push_back(to);
+        continue;
+      }
+      std::ranges::copy(ClusterSearch{*this, from}.pathTo(to),
+                        std::back_inserter(path));
+    }
+    return path;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_HIERARCHICAL_ASTAR_HH
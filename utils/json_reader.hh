@@ -0,0 +1,227 @@
+#ifndef UTILS_JSON_READER_HH
+#define UTILS_JSON_READER_HH
+
+#include <charconv>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace Utils {
+
+//
+// JsonReader provides a streaming (pull style) reader for JSON documents.
+//
+// In contrast to a JSON DOM, no part of the document is held in memory other
+// than the |text| itself. Values are read in document order, as the caller
+// walks the document using members() and elements(); any value the caller is
+// not interested in is passed over by skip():
+//
+//   auto reader = JsonReader{R"({"size": [3, 4]})"};
+//   reader.members([&](std::string_view key) {
+//     if (key == "size")
+//       reader.elements([&](size_t) { sizes.push_back(reader.number()); });
+//     else
+//       reader.skip();
+//   });
+//   if (!reader.done()) ...  // Not a valid JSON document
+//
+// Reading a value of the wrong type (ex. number() on a string) skips the value
+// and returns std::nullopt. Malformed documents stop the reader and are
+// reported by done().
+//
+class JsonReader {
+  std::string_view text_{};
+  size_t at_{};
+  bool failed_{};
+
+  constexpr void skipWhitespace() {
+    while (at_ < text_.size() and (text_[at_] == ' ' or text_[at_] == '\n' or
+                                   text_[at_] == '\r' or text_[at_] == '\t'))
+      ++at_;
+  }
+
+  [[nodiscard]] constexpr auto peek() -> char {
+    skipWhitespace();
+    return at_ < text_.size() ? text_[at_] : '\0';
+  }
+
+  // Consumes |expected| if it is the next character
+  [[nodiscard]] constexpr auto consume(char expected) -> bool {
+    if (failed_ or peek() != expected) return false;
+    ++at_;
+    return true;
+  }
+
+  constexpr void fail() {
+    failed_ = true;
+    at_     = text_.size();
+  }
+
+  // Returns the raw text of a string, excluding quotes (escapes left as is)
+  [[nodiscard]] constexpr auto rawString() -> std::optional<std::string_view> {
+    if (!consume('"')) return std::nullopt;
+    const auto start = at_;
+    for (; at_ < text_.size() and text_[at_] != '"'; ++at_)
+      if (text_[at_] == '\\') ++at_;
+    if (at_ >= text_.size()) {
+      fail();
+      return std::nullopt;
+    }
+    return text_.substr(start, at_++ - start);
+  }
+
+  // Consumes a literal (number, true, false or null)
+  [[nodiscard]] constexpr auto literal() -> std::string_view {
+    const auto start = at_;
+    while (at_ < text_.size()) {
+      const auto next = text_[at_];
+      if (next == ',' or next == ']' or next == '}' or next == ' ' or
+          next == '\n' or next == '\r' or next == '\t')
+        break;
+      ++at_;
+    }
+    if (at_ == start) fail();
+    return text_.substr(start, at_ - start);
+  }
+
+  [[nodiscard]] static constexpr auto isNumber(std::string_view token) -> bool {
+    return !token.empty() and (token.front() == '-' or
+                               (token.front() >= '0' and token.front() <= '9'));
+  }
+
+ public:
+  [[nodiscard]] explicit constexpr JsonReader(std::string_view text)
+      : text_{text} {}
+
+  // Returns true once the entire document has been read successfully
+  [[nodiscard]] constexpr auto done() -> bool {
+    return !failed_ and peek() == '\0' and at_ == text_.size();
+  }
+
+  //
+  // members() reads an object, invoking |on_member| with the key of each
+  // member. |on_member| must read (or skip()) the value of the member.
+  //
+  constexpr auto members(auto&& on_member) -> bool {
+    if (!consume('{')) {
+      skip();
+      return false;
+    }
+    if (consume('}')) return true;
+    do {
+      const auto key = rawString();
+      if (!key or !consume(':')) {
+        fail();
+        return false;
+      }
+      on_member(*key);
+    } while (consume(','));
+    if (!consume('}')) fail();
+    return !failed_;
+  }
+
+  //
+  // elements() reads an array, invoking |on_element| with the index of each
+  // element. |on_element| must read (or skip()) the element.
+  //
+  constexpr auto elements(auto&& on_element) -> bool {
+    if (!consume('[')) {
+      skip();
+      return false;
+    }
+    if (consume(']')) return true;
+    auto index = size_t{};
+    do {
+      on_element(index++);
+    } while (consume(','));
+    if (!consume(']')) fail();
+    return !failed_;
+  }
+
+  // Returns the raw text of a number (ex. to parse it more precisely)
+  [[nodiscard]] constexpr auto numberText() -> std::optional<std::string_view> {
+    if (failed_) return std::nullopt;
+    const auto next = peek();
+    if (next != '-' and (next < '0' or next > '9')) {
+      skip();
+      return std::nullopt;
+    }
+    return literal();
+  }
+
+  [[nodiscard]] auto number() -> std::optional<double> {
+    const auto text = numberText();
+    if (!text) return std::nullopt;
+
+    auto value = double{};
+    const auto [end, error] =
+        std::from_chars(text->data(), text->data() + text->size(), value);
+    if (error != std::errc{} or end != text->data() + text->size()) {
+      fail();
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  [[nodiscard]] auto string() -> std::optional<std::string> {
+    if (failed_) return std::nullopt;
+    if (peek() != '"') {
+      skip();
+      return std::nullopt;
+    }
+
+    const auto raw = rawString();
+    if (!raw) return std::nullopt;
+
+    // Unicode escapes (\uXXXX) are passed through undecoded.
+    auto value = std::string{};
+    for (auto index = size_t{}; index < raw->size(); ++index) {
+      if ((*raw)[index] != '\\' or ++index == raw->size()) {
+        value.push_back((*raw)[index]);
+        continue;
+      }
+      switch ((*raw)[index]) {
+        case 'n': value.push_back('\n'); break;
+        case 'r': value.push_back('\r'); break;
+        case 't': value.push_back('\t'); break;
+        case 'b': value.push_back('\b'); break;
+        case 'f': value.push_back('\f'); break;
+        case 'u': value.append("\\u"); break;
+        default: value.push_back((*raw)[index]); break;
+      }
+    }
+    return value;
+  }
+
+  //
+  // skip() passes over the next value, and returns its raw text. The text can
+  // be read later on by a separate JsonReader.
+  //
+  constexpr auto skip() -> std::optional<std::string_view> {
+    if (failed_) return std::nullopt;
+
+    const auto next  = peek();
+    const auto start = at_;
+    if (next == '{') {
+      members([&](std::string_view) { skip(); });
+    } else if (next == '[') {
+      elements([&](size_t) { skip(); });
+    } else if (next == '"') {
+      if (!rawString()) return std::nullopt;
+    } else {
+      const auto token = literal();
+      if (!isNumber(token) and token != "true" and token != "false" and
+          token != "null")
+        fail();
+    }
+
+    if (failed_) return std::nullopt;
+    return text_.substr(start, at_ - start);
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_JSON_READER_HH
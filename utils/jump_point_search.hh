@@ -0,0 +1,246 @@
+#ifndef UTILS_JUMP_POINT_SEARCH_HH
+#define UTILS_JUMP_POINT_SEARCH_HH
+
+#include <algorithm>
+#include <cstdlib>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "coordinate.hh"
+#include "default_map.hh"
+#include "dijkstras.hh"
+
+namespace Utils {
+
+//
+// JumpPointSearch<> provides an implementation of the Jump Point Search (JPS)
+// path finding algorithm for uniform cost grids.
+//
+// Details:
+//   https://en.wikipedia.org/wiki/Jump_point_search
+//
+// JPS is an optimization of the A* algorithm, which prunes symmetric paths by
+// "jumping" along straight lines until a point of interest (a jump point) is
+// found. Only jump points are added to the open list, which significantly
+// reduces the number of nodes expanded on large, open grids.
+//
+// The |passable| parameter specifies a callable operator or function that
+// returns true if a given coordinate may be entered. It must return false for
+// coordinates outside the grid.
+//
+// Orthogonal steps have a cost of 1 (or 10 and 14 for orthogonal and diagonal
+// steps respectively if diagonal movement is enabled).
+//
+// This function returns the full, step-by-step path from |start| to |goal|
+// (both included), or an empty vector if the goal cannot be reached.
+//
+template <Movement MOVEMENT>
+struct JumpPointSearch {
+  [[nodiscard]] static auto find(Coordinate start, Coordinate goal,
+                                 auto&& passable) -> std::vector<Coordinate> {
+    if (!passable(start) or !passable(goal)) return {};
+
+    auto distances = default_map<Coordinate, int>{};
+    auto previous  = std::unordered_map<Coordinate, Coordinate>{};
+
+    // Queue entries are ordered by the estimated total distance (distance
+    // travelled + heuristic), not the distance travelled.
+    auto queue       = std::priority_queue<WeightedEdge<int, Coordinate>>{};
+    distances[start] = 0;
+    queue.push({heuristic(start, goal), start});
+
+    while (!queue.empty()) {
+      const auto [estimate, current] = queue.top();
+      queue.pop();
+      if (current == goal) return expand(start, goal, previous);
+
+      // Skip queue entries superseded by a shorter distance
+      const auto distance = distances.at_or_max(current);
+      if (distance + heuristic(current, goal) < estimate) continue;
+
+      const auto parent = previous.contains(current)
+                              ? std::optional{previous.at(current)}
+                              : std::nullopt;
+      for (const auto direction : directions(current, parent, passable)) {
+        const auto jump_point = jump(current, direction, goal, passable);
+        if (!jump_point) continue;
+
+        const auto candidate = distance + cost(current, *jump_point);
+        if (candidate < distances.at_or_max(*jump_point)) {
+          distances[*jump_point] = candidate;
+          previous[*jump_point]  = current;
+          queue.push(
+              {candidate + heuristic(*jump_point, goal), *jump_point});
+        }
+      }
+    }
+
+    return {};
+  }
+
+ private:
+  static constexpr auto STRAIGHT = MOVEMENT == Movement::Diagonal ? 10 : 1;
+  static constexpr auto DIAGONAL = 14;
+
+  // Returns the unit step direction from |from| towards |to|
+  [[nodiscard]] static constexpr auto directionOf(Coordinate from,
+                                                  Coordinate to)
+      -> Coordinate {
+    return {.x = (to.x > from.x) - (to.x < from.x),
+            .y = (to.y > from.y) - (to.y < from.y)};
+  }
+
+  // Returns the cost of travelling from |from| to |to|, which must be on a
+  // straight or diagonal line.
+  [[nodiscard]] static constexpr auto cost(Coordinate from, Coordinate to)
+      -> int {
+    const auto dx = std::abs(to.x - from.x);
+    const auto dy = std::abs(to.y - from.y);
+    if constexpr (MOVEMENT == Movement::Diagonal)
+      return (STRAIGHT * std::abs(dx - dy)) + (DIAGONAL * std::min(dx, dy));
+    return dx + dy;
+  }
+
+  // Manhattan distance (orthogonal) or octile distance (diagonal movement)
+  [[nodiscard]] static constexpr auto heuristic(Coordinate from,
+                                                Coordinate goal) -> int {
+    return cost(from, goal);
+  }
+
+  // Returns true if a horizontal or vertical scan in |direction| must stop at
+  // |at|, because a neighbor can only be reached optimally through |at|.
+  [[nodiscard]] static constexpr auto hasForcedNeighbor(Coordinate at,
+                                                        Coordinate direction,
+                                                        auto&& passable)
+      -> bool {
+    const auto side = Coordinate{.x = direction.y, .y = direction.x};
+    return (passable(at + side) and !passable(at + side - direction)) or
+           (passable(at - side) and !passable(at - side - direction));
+  }
+
+  // Scans horizontally or vertically from |from| until a jump point is found
+  [[nodiscard]] static constexpr auto jumpStraight(Coordinate from,
+                                                   Coordinate direction,
+                                                   Coordinate goal,
+                                                   auto&& passable)
+      -> std::optional<Coordinate> {
+    for (auto at = from + direction; passable(at); at += direction) {
+      if (at == goal or hasForcedNeighbor(at, direction, passable)) return at;
+
+      // With orthogonal movement only, vertical scans must also stop where a
+      // horizontal scan finds a jump point.
+      if constexpr (MOVEMENT == Movement::Orthogonal) {
+        if (direction.x == 0 and
+            (jumpStraight(at, {.x = 1, .y = 0}, goal, passable) or
+             jumpStraight(at, {.x = -1, .y = 0}, goal, passable)))
+          return at;
+      }
+    }
+    return std::nullopt;
+  }
+
+  // Scans diagonally from |from| until a jump point is found
+  [[nodiscard]] static constexpr auto jumpDiagonal(Coordinate from,
+                                                   Coordinate direction,
+                                                   Coordinate goal,
+                                                   auto&& passable)
+      -> std::optional<Coordinate> {
+    const auto horizontal = Coordinate{.x = direction.x, .y = 0};
+    const auto vertical   = Coordinate{.x = 0, .y = direction.y};
+
+    auto at = from;
+    while (passable(at + horizontal) and passable(at + vertical) and
+           passable(at + direction)) {
+      at += direction;
+      if (at == goal or jumpStraight(at, horizontal, goal, passable) or
+          jumpStraight(at, vertical, goal, passable))
+        return at;
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] static constexpr auto jump(Coordinate from,
+                                           Coordinate direction,
+                                           Coordinate goal, auto&& passable)
+      -> std::optional<Coordinate> {
+    if (direction.x != 0 and direction.y != 0)
+      return jumpDiagonal(from, direction, goal, passable);
+    return jumpStraight(from, direction, goal, passable);
+  }
+
+  // Returns the (pruned) directions to explore from |at|, given the |parent|
+  // jump point it was reached from.
+  [[nodiscard]] static auto directions(Coordinate at,
+                                       std::optional<Coordinate> parent,
+                                       auto&& passable)
+      -> std::vector<Coordinate> {
+    auto result = std::vector<Coordinate>{};
+    const auto add = [&](Coordinate direction) {
+      if (passable(at + direction)) result.push_back(direction);
+    };
+
+    if (!parent) {
+      if constexpr (MOVEMENT == Movement::Diagonal) {
+        for (const auto direction : Coordinate{}.neighbors())
+          if (direction.x == 0 or direction.y == 0 or
+              (passable(at + Coordinate{.x = direction.x, .y = 0}) and
+               passable(at + Coordinate{.x = 0, .y = direction.y})))
+            add(direction);
+      } else {
+        for (const auto direction : Coordinate{}.neighborsUpDownLeftRight())
+          add(direction);
+      }
+      return result;
+    }
+
+    const auto direction  = directionOf(*parent, at);
+    const auto horizontal = Coordinate{.x = direction.x, .y = 0};
+    const auto vertical   = Coordinate{.x = 0, .y = direction.y};
+
+    if (direction.x != 0 and direction.y != 0) {
+      // Diagonal: continue diagonally as well as along both components
+      add(horizontal);
+      add(vertical);
+      if (passable(at + horizontal) and passable(at + vertical))
+        add(direction);
+      return result;
+    }
+
+    // Straight: continue straight, as well as turn to either side
+    const auto side = Coordinate{.x = direction.y, .y = direction.x};
+    add(direction);
+    add(side);
+    add(side.flipped());
+    if constexpr (MOVEMENT == Movement::Diagonal) {
+      if (passable(at + direction)) {
+        if (passable(at + side)) add(direction + side);
+        if (passable(at - side)) add(direction - side);
+      }
+    }
+    return result;
+  }
+
+  // Expands the jump points leading to |goal| into a step-by-step path
+  [[nodiscard]] static auto expand(
+      Coordinate start, Coordinate goal,
+      const std::unordered_map<Coordinate, Coordinate>& previous)
+      -> std::vector<Coordinate> {
+    auto path = std::vector<Coordinate>{goal};
+    for (auto at = goal; at != start;) {
+      const auto parent    = previous.at(at);
+      const auto direction = directionOf(at, parent);
+      while (at != parent) {
+        at += direction;
+        path.push_back(at);
+      }
+    }
+    std::ranges::reverse(path);
+    return path;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_JUMP_POINT_SEARCH_HH
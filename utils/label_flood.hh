@@ -0,0 +1,181 @@
+#ifndef UTILS_LABEL_FLOOD_HH
+#define UTILS_LABEL_FLOOD_HH
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "coordinate.hh"
+
+namespace Utils {
+
+//
+// LabelFlood<> performs a breadth-first flood fill from up to eight labelled
+// starting points on a width x height grid of uniform cost, propagating the
+// distance fronts of all labels in a single traversal of the grid.
+//
+// For every grid cell, a bit mask records which labels have reached the cell,
+// and two bits per label record the direction to the previous cell on the
+// shortest path back to that label's starting point. The cost of a flood is
+// therefore largely independent of the number of labels.
+//
+// If a cell can be reached through multiple neighbors at the same distance,
+// the first neighbor in neighborsUpDownLeftRight() order is chosen. The result
+// for each label is thus identical to flooding that label on its own.
+//
+template <size_t LABELS>
+  requires(LABELS <= 8)
+class LabelFlood {
+  using Mask = uint8_t;
+
+  size_t width_{};
+  size_t height_{};
+  std::vector<Mask> reached_{};
+  std::vector<uint16_t> directions_{};
+
+  [[nodiscard]] constexpr auto indexOf(Coordinate coordinate) const -> size_t {
+    return (static_cast<size_t>(coordinate.y) * width_) +
+           static_cast<size_t>(coordinate.x);
+  }
+
+  [[nodiscard]] constexpr auto coordinateOf(size_t index) const -> Coordinate {
+    return {.x = static_cast<int>(index % width_),
+            .y = static_cast<int>(index / width_)};
+  }
+
+  [[nodiscard]] constexpr auto directionOf(size_t label, size_t index) const
+      -> size_t {
+    return (directions_[index] >> (label * 2)) & 0b11U;
+  }
+
+  constexpr void setDirection(size_t label, size_t index, size_t direction) {
+    const auto shift   = label * 2;
+    directions_[index] = static_cast<uint16_t>(
+        (directions_[index] & ~(0b11U << shift)) | (direction << shift));
+  }
+
+  [[nodiscard]] LabelFlood(size_t width, size_t height)
+      : width_{width},
+        height_{height},
+        reached_(width * height),
+        directions_(width * height) {}
+
+ public:
+  //
+  // PathMap provides the previous map of a single label, compatible with the
+  // contains()/at() interface of GridDijkstra<>::PathMap.
+  //
+  class PathMap {
+    const LabelFlood* flood_;
+    size_t label_;
+
+   public:
+    [[nodiscard]] constexpr PathMap(const LabelFlood& flood, size_t label)
+        : flood_{&flood}, label_{label} {}
+
+    [[nodiscard]] constexpr auto contains(Coordinate coordinate) const
+        -> bool {
+      return flood_->contains(label_, coordinate);
+    }
+
+    [[nodiscard]] constexpr auto at(Coordinate coordinate) const
+        -> Coordinate {
+      return flood_->at(label_, coordinate);
+    }
+  };
+
+  //
+  // find() floods the grid from all |starts|, where a start is given per label
+  // (or std::nullopt if a label has no starting point). The |passable|
+  // parameter specifies a callable operator or function that returns true if
+  // a given coordinate may be entered and must return false for coordinates
+  // outside the grid.
+  //
+  [[nodiscard]] static auto find(
+      size_t width, size_t height,
+      const std::array<std::optional<Coordinate>, LABELS>& starts,
+      auto&& passable) -> LabelFlood {
+    auto flood = LabelFlood{width, height};
+
+    // Labels newly reached per cell, for the current and next distance
+    auto frontier = std::vector<std::pair<size_t, Mask>>{};
+    auto next     = std::vector<size_t>{};
+    auto arriving = std::vector<Mask>(width * height);
+
+    for (auto label = size_t{}; label < LABELS; ++label) {
+      if (!starts[label]) continue;
+      const auto index = flood.indexOf(*starts[label]);
+      if (arriving[index] == 0) next.push_back(index);
+      arriving[index] |= static_cast<Mask>(1U << label);
+      flood.reached_[index] |= static_cast<Mask>(1U << label);
+    }
+
+    while (!next.empty()) {
+      frontier.clear();
+      for (const auto index : next)
+        frontier.emplace_back(index, std::exchange(arriving[index], 0));
+      next.clear();
+
+      for (const auto& [index, labels] : frontier) {
+        const auto from      = flood.coordinateOf(index);
+        const auto neighbors = from.neighborsUpDownLeftRight();
+        for (auto direction = size_t{}; direction < neighbors.size();
+             ++direction) {
+          const auto to = neighbors[direction];
+          if (!passable(to)) continue;
+
+          const auto to_index = flood.indexOf(to);
+          // The direction back from |to| to |from| is the opposite of
+          // |direction| (Up <-> Down, Left <-> Right).
+          const auto back = direction ^ 1U;
+
+          // Prefer the first neighbor (in direction order) on ties
+          const auto ties = static_cast<Mask>(labels & arriving[to_index]);
+          for (auto label = size_t{}; label < LABELS; ++label) {
+            if (((ties >> label) & 1U) != 0 and
+                back < flood.directionOf(label, to_index))
+              flood.setDirection(label, to_index, back);
+          }
+
+          const auto fresh =
+              static_cast<Mask>(labels & ~flood.reached_[to_index]);
+          if (fresh == 0) continue;
+
+          if (arriving[to_index] == 0) next.push_back(to_index);
+          arriving[to_index] |= fresh;
+          flood.reached_[to_index] |= fresh;
+          for (auto label = size_t{}; label < LABELS; ++label) {
+            if (((fresh >> label) & 1U) != 0)
+              flood.setDirection(label, to_index, back);
+          }
+        }
+      }
+    }
+
+    return flood;
+  }
+
+  [[nodiscard]] constexpr auto contains(size_t label,
+                                        Coordinate coordinate) const -> bool {
+    return coordinate.x >= 0 and static_cast<size_t>(coordinate.x) < width_ and
+           coordinate.y >= 0 and static_cast<size_t>(coordinate.y) < height_ and
+           ((reached_[indexOf(coordinate)] >> label) & 1U) != 0;
+  }
+
+  // Only valid if contains(label, coordinate) returns true.
+  [[nodiscard]] constexpr auto at(size_t label, Coordinate coordinate) const
+      -> Coordinate {
+    const auto direction = directionOf(label, indexOf(coordinate));
+    return coordinate.neighborsUpDownLeftRight()[direction];
+  }
+
+  [[nodiscard]] constexpr auto pathMap(size_t label) const -> PathMap {
+    return PathMap{*this, label};
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_LABEL_FLOOD_HH
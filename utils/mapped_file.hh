@@ -0,0 +1,74 @@
+#ifndef UTILS_MAPPED_FILE_HH
+#define UTILS_MAPPED_FILE_HH
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace Utils {
+
+//
+// MappedFile maps the content of a file into memory (read-only) for as long as
+// the object lives.
+//
+// Returns std::nullopt from open() if the file does not exist or could not be
+// mapped. Empty files cannot be mapped.
+//
+class MappedFile {
+  void* data_{};
+  size_t size_{};
+
+  [[nodiscard]] MappedFile(void* data, size_t size)
+      : data_{data}, size_{size} {}
+
+ public:
+  [[nodiscard]] static auto open(const std::filesystem::path& path)
+      -> std::optional<MappedFile> {
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return std::nullopt;
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 or info.st_size <= 0) {
+      ::close(fd);
+      return std::nullopt;
+    }
+
+    const auto size = static_cast<size_t>(info.st_size);
+    auto* data      = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping remains valid after closing
+    if (data == MAP_FAILED) return std::nullopt;
+    return MappedFile{data, size};
+  }
+
+  MappedFile(const MappedFile&)                    = delete;
+  auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+  [[nodiscard]] MappedFile(MappedFile&& other) noexcept
+      : data_{std::exchange(other.data_, nullptr)},
+        size_{std::exchange(other.size_, 0)} {}
+
+  auto operator=(MappedFile&& other) noexcept -> MappedFile& {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+
+  ~MappedFile() {
+    if (data_ != nullptr) ::munmap(data_, size_);
+  }
+
+  [[nodiscard]] auto bytes() const -> std::span<const std::byte> {
+    return {static_cast<const std::byte*>(data_), size_};
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_MAPPED_FILE_HH
@@ -0,0 +1,150 @@
+#ifndef UTILS_NEIGHBORHOOD_HH
+#define UTILS_NEIGHBORHOOD_HH
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "coordinate.hh"
+#include "cost_grid.hh"
+
+namespace Utils {
+
+//
+// FixedNeighbors<> holds up to CAPACITY edges in place, providing an iterable
+// range of the neighbors of a grid cell without any heap allocation.
+//
+template <typename EDGE, size_t CAPACITY>
+class FixedNeighbors {
+  std::array<EDGE, CAPACITY> edges_{};
+  size_t size_{};
+
+ public:
+  constexpr void push_back(const EDGE& edge) { edges_[size_++] = edge; }
+
+  [[nodiscard]] constexpr auto size() const { return size_; }
+
+  [[nodiscard]] constexpr auto begin() const { return edges_.begin(); }
+  [[nodiscard]] constexpr auto end() const { return edges_.begin() + size_; }
+};
+
+//
+// NeighborhoodPolicy<> defines which neighbors of a grid cell can be reached
+// in a single step, and at what (integer) cost.
+//
+// Orthogonal movement reaches the four neighbors up, down, left and right (in
+// that order, see Coordinate::neighborsUpDownLeftRight()), at STRAIGHT cost.
+// Diagonal movement additionally reaches the four diagonal neighbors (see
+// Coordinate::neighorsDiagonal()) at DIAGONAL cost, as long as both orthogonal
+// cells next to the diagonal step are passable (i.e. no corner cutting).
+//
+// The step offsets are computed at compile time and the neighbor loop is fully
+// unrolled, so adjacent() compiles down to a fixed sequence of passability
+// checks. On weighted terrain (see CostGrid), each step cost is additionally
+// multiplied by the cost of entering the neighbor.
+//
+template <Movement MOVEMENT, int STRAIGHT, int DIAGONAL = STRAIGHT>
+class NeighborhoodPolicy {
+  // Invokes |fn| with every index in [0, COUNT), unrolled at compile time
+  template <size_t COUNT>
+  static constexpr void unrolled(auto&& fn) {
+    [&]<size_t... INDEX>(std::index_sequence<INDEX...>) {
+      (fn(std::integral_constant<size_t, INDEX>{}), ...);
+    }(std::make_index_sequence<COUNT>{});
+  }
+
+ public:
+  static constexpr auto SIZE = size_t{MOVEMENT == Movement::Diagonal ? 8 : 4};
+
+  // Step offsets; orthogonal steps first, followed by diagonal steps
+  static constexpr auto OFFSETS = [] {
+    auto offsets = std::array<Coordinate, SIZE>{};
+    for (auto step = size_t{}; step < 4; ++step) {
+      offsets[step] = Coordinate{}.neighborsUpDownLeftRight()[step];
+      if constexpr (SIZE == 8)
+        offsets[4 + step] = Coordinate{}.neighorsDiagonal()[step];
+    }
+    return offsets;
+  }();
+
+  //
+  // adjacent() returns all neighbors of |from| for which the |passable|
+  // predicate returns true, as edges of type EDGE (ex. WeightedEdge<>).
+  //
+  template <typename EDGE>
+  [[nodiscard]] static constexpr auto adjacent(Coordinate from,
+                                               auto&& passable)
+      -> FixedNeighbors<EDGE, SIZE> {
+    return weighted<EDGE>(
+        from, [&](Coordinate to) { return passable(to) ? 1 : 0; });
+  }
+
+  //
+  // adjacent() variant that weighs every step by the cost of entering the
+  // neighbor on the |costs| grid, skipping IMPASSABLE neighbors.
+  //
+  template <typename EDGE>
+  [[nodiscard]] static constexpr auto adjacent(Coordinate from,
+                                               const CostGrid& costs)
+      -> FixedNeighbors<EDGE, SIZE> {
+    return weighted<EDGE>(from, [&](Coordinate to) -> int {
+      const auto cost = costs.cost(to);
+      return cost == CostGrid::IMPASSABLE ? 0 : cost;
+    });
+  }
+
+ private:
+  // Collects the neighbors of |from|, with the step cost multiplied by the
+  // |weight| of the neighbor. Neighbors of weight 0 cannot be entered.
+  template <typename EDGE>
+  [[nodiscard]] static constexpr auto weighted(Coordinate from,
+                                               auto&& weight)
+      -> FixedNeighbors<EDGE, SIZE> {
+    using Distance = decltype(EDGE{}.distance);
+    auto neighbors = FixedNeighbors<EDGE, SIZE>{};
+
+    auto open = std::array<bool, 4>{};
+    unrolled<4>([&](auto step) {
+      const auto to     = from + OFFSETS[step];
+      const auto factor = weight(to);
+      open[step]        = factor != 0;
+      if (open[step])
+        neighbors.push_back({static_cast<Distance>(STRAIGHT * factor), to});
+    });
+
+    if constexpr (SIZE == 8) {
+      // Orthogonal steps (vertical, horizontal) next to each diagonal step
+      constexpr auto BESIDE = std::array<std::pair<size_t, size_t>, 4>{
+          {{0, 2}, {1, 3}, {0, 3}, {1, 2}}};
+
+      unrolled<4>([&](auto step) {
+        const auto [vertical, horizontal] = BESIDE[step];
+        if (!open[vertical] or !open[horizontal]) return;
+
+        const auto to     = from + OFFSETS[4 + step];
+        const auto factor = weight(to);
+        if (factor != 0)
+          neighbors.push_back({static_cast<Distance>(DIAGONAL * factor), to});
+      });
+    }
+    return neighbors;
+  }
+};
+
+namespace Neighborhood {
+
+// Up, down, left and right, at a cost of 1 per step
+using FourConnected = NeighborhoodPolicy<Movement::Orthogonal, 1>;
+
+// All eight neighbors, at a cost of 1 per step (no corner cutting)
+using EightConnected = NeighborhoodPolicy<Movement::Diagonal, 1>;
+
+// All eight neighbors, at integer octile costs (10 straight, 14 diagonal)
+using Octile = NeighborhoodPolicy<Movement::Diagonal, 10, 14>;
+
+}  // namespace Neighborhood
+
+}  // namespace Utils
+
+#endif  // UTILS_NEIGHBORHOOD_HH
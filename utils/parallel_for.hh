@@ -0,0 +1,42 @@
+#ifndef UTILS_PARALLEL_FOR_HH
+#define UTILS_PARALLEL_FOR_HH
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Utils {
+
+//
+// parallelFor() calls |function| once for every index in [0, count), spread
+// across up to |threads| worker threads. A |threads| value of 0 uses all
+// available hardware threads.
+//
+// Indices are handed out to workers through a shared atomic counter, so
+// uneven amounts of work per index balance out across the workers. The calling
+// thread acts as one of the workers; the function returns once all indices
+// have been processed.
+//
+// |function| is called concurrently and must only write to state owned by its
+// index (ex. a pre-sized results vector) to avoid contention.
+//
+void parallelFor(size_t count, size_t threads, auto&& function) {
+  if (threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+  threads = std::min(threads, count);
+
+  auto next         = std::atomic<size_t>{};
+  const auto worker = [&] {
+    for (auto index = next++; index < count; index = next++) function(index);
+  };
+
+  auto workers = std::vector<std::jthread>{};
+  workers.reserve(threads > 0 ? threads - 1 : 0);
+  for (auto thread = size_t{1}; thread < threads; ++thread)
+    workers.emplace_back(worker);
+  worker();
+}
+
+}  // namespace Utils
+
+#endif  // UTILS_PARALLEL_FOR_HH
@@ -0,0 +1,107 @@
+#ifndef UTILS_RADIX_HEAP_HH
+#define UTILS_RADIX_HEAP_HH
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "dijkstras.hh"
+
+namespace Utils {
+
+//
+// RadixHeap<> provides a monotone priority queue for integral distances of
+// arbitrary range.
+//
+// Details:
+//   https://en.wikipedia.org/wiki/Radix_heap
+//
+// Edges are sorted into buckets by the highest bit in which their distance
+// differs from the most recently popped distance. Pushing is O(1) and popping
+// is amortized O(log C) for a maximum edge cost C. This makes the radix heap
+// the better choice over BucketQueue<> if edge costs vary widely.
+//
+// As with BucketQueue<>, the radix heap is designed for monotone use. Pushing
+// an edge shorter than the edge most recently popped is supported, but requires
+// re-distributing all queued edges.
+//
+template <typename DISTANCE, typename EDGE>
+  requires std::is_integral_v<DISTANCE>
+class RadixHeap {
+  using Edge = WeightedEdge<DISTANCE, EDGE>;
+  using Key  = std::make_unsigned_t<DISTANCE>;
+
+  static constexpr auto BUCKETS = std::numeric_limits<Key>::digits + 1;
+
+  // Bucket 0 holds edges at the last popped distance. It is only refilled once
+  // the next edge is requested, since edges at the distance most recently
+  // popped may still be pushed.
+  std::array<std::vector<Edge>, BUCKETS> buckets_{};
+  Key last_{};
+  size_t size_{};
+
+  [[nodiscard]] constexpr auto bucketOf(DISTANCE distance) const -> size_t {
+    return static_cast<size_t>(
+        std::bit_width(static_cast<Key>(static_cast<Key>(distance) ^ last_)));
+  }
+
+  // Re-distributes all queued edges relative to a new (lower) |last| distance
+  constexpr void rebase(Key last) {
+    auto edges = std::vector<Edge>{};
+    edges.reserve(size_);
+    for (auto& bucket : buckets_) {
+      std::ranges::move(bucket, std::back_inserter(edges));
+      bucket.clear();
+    }
+    last_ = last;
+    for (auto& edge : edges)
+      buckets_[bucketOf(edge.distance)].push_back(std::move(edge));
+  }
+
+  // Moves the edges of the first non-empty bucket into lower buckets
+  constexpr void refill() {
+    if (size_ == 0 or !buckets_[0].empty()) return;
+
+    auto bucket = std::ranges::find_if(
+        buckets_, [](const auto& edges) { return !edges.empty(); });
+    last_ = static_cast<Key>(
+        std::ranges::min(*bucket, {}, &Edge::distance).distance);
+
+    for (auto& edge : *bucket)
+      buckets_[bucketOf(edge.distance)].push_back(std::move(edge));
+    bucket->clear();
+  }
+
+ public:
+  [[nodiscard]] constexpr auto empty() const -> bool { return size_ == 0; }
+
+  [[nodiscard]] constexpr auto size() const -> size_t { return size_; }
+
+  [[nodiscard]] constexpr auto top() -> const Edge& {
+    refill();
+    return buckets_[0].back();
+  }
+
+  constexpr void push(const Edge& edge) {
+    if (size_ == 0) last_ = static_cast<Key>(edge.distance);
+    if (static_cast<Key>(edge.distance) < last_)
+      rebase(static_cast<Key>(edge.distance));
+
+    buckets_[bucketOf(edge.distance)].push_back(edge);
+    ++size_;
+  }
+
+  constexpr void pop() {
+    refill();
+    buckets_[0].pop_back();
+    --size_;
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_RADIX_HEAP_HH
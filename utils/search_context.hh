@@ -0,0 +1,147 @@
+#ifndef UTILS_SEARCH_CONTEXT_HH
+#define UTILS_SEARCH_CONTEXT_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+#include "coordinate.hh"
+#include "dijkstras.hh"
+
+namespace Utils {
+
+//
+// SearchContext<> provides the working storage (distances, predecessors and
+// the search frontier) of grid searches such as GridDijkstra<> and
+// GridAStar<>, so it can be reused across any number of searches.
+//
+// Every cell is stamped with the generation of the search that last visited
+// it, and cells stamped by an earlier search read as unvisited. Starting a new
+// search (reset()) thus takes O(1) time, rather than clearing every cell.
+// Storage is only reallocated when a larger grid is searched, so back-to-back
+// searches on the same grid perform no heap allocations once the frontier has
+// grown to its working size.
+//
+// The per-cell storage is allocated from the given memory |resource| (ex. a
+// std::pmr::monotonic_buffer_resource arena), or the default resource.
+//
+// Once a search completes, the context provides the same contains()/at()
+// interface as FlatPathMap, as well as the distance() of every visited cell.
+//
+template <typename DISTANCE,
+          template <typename, typename> typename FRONTIER = PriorityQueue>
+  requires std::is_integral_v<DISTANCE> or std::is_floating_point_v<DISTANCE>
+class SearchContext {
+ public:
+  using Frontier = FRONTIER<DISTANCE, Coordinate>;
+
+  static constexpr auto UNREACHED = std::numeric_limits<DISTANCE>::max();
+
+ private:
+  static constexpr auto NONE = std::numeric_limits<uint32_t>::max();
+
+  size_t width_{};
+  size_t height_{};
+  uint32_t generation_{};
+  std::pmr::vector<uint32_t> visited_;
+  std::pmr::vector<DISTANCE> distances_;
+  std::pmr::vector<uint32_t> previous_;
+  Frontier frontier_{};
+
+  [[nodiscard]] constexpr auto indexOf(Coordinate coordinate) const -> size_t {
+    return (static_cast<size_t>(coordinate.y) * width_) +
+           static_cast<size_t>(coordinate.x);
+  }
+
+  [[nodiscard]] constexpr auto visited(size_t index) const -> bool {
+    return visited_[index] == generation_;
+  }
+
+ public:
+  [[nodiscard]] explicit SearchContext(
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : visited_{resource}, distances_{resource}, previous_{resource} {}
+
+  //
+  // reset() starts a new search on a |width| x |height| grid, forgetting all
+  // cells visited (and frontier entries left) by the previous search.
+  //
+  void reset(size_t width, size_t height) {
+    width_  = width;
+    height_ = height;
+
+    const auto cells = width * height;
+    if (cells > visited_.size()) {
+      visited_.resize(cells);
+      distances_.resize(cells);
+      previous_.resize(cells);
+    }
+
+    // Stamps are only cleared once the generation counter wraps
+    if (++generation_ == 0) {
+      std::ranges::fill(visited_, 0);
+      generation_ = 1;
+    }
+
+    // Popping (rather than re-creating) the frontier keeps its storage for the
+    // next search.
+    while (!frontier_.empty()) frontier_.pop();
+  }
+
+  [[nodiscard]] constexpr auto frontier() -> Frontier& { return frontier_; }
+
+  [[nodiscard]] constexpr auto width() const { return width_; }
+
+  [[nodiscard]] constexpr auto height() const { return height_; }
+
+  [[nodiscard]] constexpr auto inBounds(Coordinate coordinate) const -> bool {
+    return coordinate.x >= 0 and static_cast<size_t>(coordinate.x) < width_ and
+           coordinate.y >= 0 and static_cast<size_t>(coordinate.y) < height_;
+  }
+
+  // Returns UNREACHED for cells not visited or out of bounds
+  [[nodiscard]] constexpr auto distance(Coordinate coordinate) const
+      -> DISTANCE {
+    if (!inBounds(coordinate)) return UNREACHED;
+    const auto index = indexOf(coordinate);
+    return visited(index) ? distances_[index] : UNREACHED;
+  }
+
+  [[nodiscard]] constexpr auto contains(Coordinate coordinate) const -> bool {
+    if (!inBounds(coordinate)) return false;
+    const auto index = indexOf(coordinate);
+    return visited(index) and previous_[index] != NONE;
+  }
+
+  // Only valid if contains(coordinate) returns true.
+  [[nodiscard]] constexpr auto at(Coordinate coordinate) const -> Coordinate {
+    const auto index = previous_[indexOf(coordinate)];
+    return {.x = static_cast<int>(index % width_),
+            .y = static_cast<int>(index / width_)};
+  }
+
+  // Marks the starting point of a search, which has no predecessor.
+  // Unchecked access; |coordinate| must be within the grid.
+  constexpr void visit(Coordinate coordinate, DISTANCE distance) {
+    const auto index  = indexOf(coordinate);
+    visited_[index]   = generation_;
+    distances_[index] = distance;
+    previous_[index]  = NONE;
+  }
+
+  // Unchecked access; |coordinate| must be within the grid.
+  constexpr void relax(Coordinate coordinate, DISTANCE distance,
+                       Coordinate previous) {
+    const auto index  = indexOf(coordinate);
+    visited_[index]   = generation_;
+    distances_[index] = distance;
+    previous_[index]  = static_cast<uint32_t>(indexOf(previous));
+  }
+};
+
+}  // namespace Utils
+
+#endif  // UTILS_SEARCH_CONTEXT_HH